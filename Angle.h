@@ -0,0 +1,229 @@
+/*!
+ *  \file Angle.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <array>
+#include <type_traits>
+
+/*!
+	\brief Full wave sine table shared by every Angle type
+	\details The table holds one revolution of sin in Q30 with one guard entry so that the entry after the last
+				index is always valid for interpolation. It is built at compile time from a Taylor series on the
+				first quadrant and mirrored, so the contents are identical on every platform and standard library.
+*/
+struct SineTable
+{
+	/*! Number of index bits, the table covers one revolution in 2^BITS steps */
+	static constexpr int BITS = 10;
+
+	/*! Number of steps in one revolution */
+	static constexpr int SIZE = 1 << BITS;
+
+	/*! Number of fractional bits of the table entries */
+	static constexpr int FRACTION = 30;
+
+	/*!
+		\brief Evaluate sin(x) for x within the first quadrant using a Taylor series
+		\param x The angle in radians, in [0, pi/2]
+		\returns sin(x)
+	*/
+	static constexpr double taylorSine(double x)
+	{
+		double term = x;
+		double sum = x;
+
+		for (int n = 1; n < 16; ++n)
+		{
+			term *= -x * x / ((2 * n) * (2 * n + 1));
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	static constexpr std::array<std::int32_t, SIZE + 1> build()
+	{
+		constexpr double PI = 3.14159265358979323846;
+		constexpr int QUARTER = SIZE / 4;
+
+		std::array<std::int32_t, SIZE + 1> table {};
+
+		for (int i = 0; i <= QUARTER; ++i)
+		{
+			double value = taylorSine(PI / 2.0 * i / QUARTER) * static_cast<double>(1 << FRACTION);
+			table[i] = static_cast<std::int32_t>(value + 0.5);
+		}
+
+		for (int i = 1; i < QUARTER; ++i)
+		{
+			table[QUARTER + i] = table[QUARTER - i];
+		}
+
+		for (int i = 0; i < 2 * QUARTER; ++i)
+		{
+			table[2 * QUARTER + i] = -table[i];
+		}
+
+		table[SIZE] = table[0];
+		return table;
+	}
+
+	static const std::array<std::int32_t, SIZE + 1> VALUES;
+};
+
+inline constexpr std::array<std::int32_t, SineTable::SIZE + 1> SineTable::VALUES = SineTable::build();
+
+/*!
+	\class Angle
+	\brief Templated class to handle binary angles, where the full range of the integer is one revolution
+	\details Wrapping around the circle is the natural overflow of the integer so there is no renormalisation after
+				arithmetic. Arithmetic is carried out on the unsigned representation to keep the overflow well
+				defined. Signed T reads as [-pi, pi) and unsigned T as [0, 2pi).
+	\tparam T The integer type holding the angle. This is limited to the 8, 16, and 32 bit options.
+*/
+template <typename T>
+class Angle
+{
+	static_assert(std::is_integral<T>::value, "The Base T must be of an Integral type");
+	static_assert(sizeof(T) <= 4, "The Base T of an Angle is limited to 32 bits");
+
+	/*! Unsigned type used for the wrapping arithmetic */
+	typedef typename std::make_unsigned<T>::type UT;
+
+	/*! Number of bits in one revolution */
+	static const int N = sizeof(T) * 8;
+
+	/*! 2^33 / 2pi, the scale from radians to a 33 bit revolution */
+	static const std::int64_t RADIANS_TO_ANGLE = 1367130551;
+
+	/*! 2pi * 2^29, the scale from a revolution to radians */
+	static const std::int64_t ANGLE_TO_RADIANS = 3373259426;
+
+public:
+	/*!
+		\brief Default constructor.
+	*/
+	Angle() = default;
+
+	/*!
+		\brief Parameterised constructor. Converts a fixed point number of radians to a binary angle.
+		\details Any number of revolutions is accepted, the result is the angle modulo one revolution.
+		\param radians The angle in radians
+	*/
+	template <typename U, std::int8_t G>
+	explicit Angle(const FixedPoint<U, G>& radians);
+
+	T raw() const { return _data; }
+	void raw(const T& value) { _data = value; }
+
+	/*!
+		\brief Creates a new angle object from the raw binary angle
+		\param data The raw angle where the full range of T is one revolution
+		\returns An angle with the raw data as the parameter
+	*/
+	static Angle<T> createAngle(T data);
+
+	/*!
+		\brief Converts the angle to radians
+		\tparam U The data type of the fixed point radians
+		\tparam G The fractional amount of the fixed point radians
+		\returns The angle in radians, in [-pi, pi) for signed T and [0, 2pi) for unsigned T
+	*/
+	template <typename U, std::int8_t G>
+	FixedPoint<U, G> toRadians() const;
+
+	/*!
+		\brief Sine of the angle, read from the shared table using the top bits of the angle as the index and
+				linearly interpolated with the bits below
+		\tparam U The data type of the fixed point result
+		\tparam G The fractional amount of the fixed point result
+		\returns sin of the angle
+	*/
+	template <typename U, std::int8_t G>
+	FixedPoint<U, G> sin() const;
+
+	/*!
+		\brief Cosine of the angle, the sine of the angle a quarter revolution ahead
+		\tparam U The data type of the fixed point result
+		\tparam G The fractional amount of the fixed point result
+		\returns cos of the angle
+	*/
+	template <typename U, std::int8_t G>
+	FixedPoint<U, G> cos() const;
+
+	Angle<T> operator+(const Angle<T>& rhs) const { return createAngle(static_cast<T>(UT(_data) + UT(rhs._data))); }
+	Angle<T>& operator+=(const Angle<T>& rhs) { *this = *this + rhs; return *this; }
+
+	Angle<T> operator-(const Angle<T>& rhs) const { return createAngle(static_cast<T>(UT(_data) - UT(rhs._data))); }
+	Angle<T>& operator-=(const Angle<T>& rhs) { *this = *this - rhs; return *this; }
+
+	Angle<T> operator-() const { return createAngle(static_cast<T>(UT(0) - UT(_data))); }
+
+	Angle<T> operator*(const std::int32_t& scale) const { return createAngle(static_cast<T>(std::uint32_t(UT(_data)) * std::uint32_t(scale))); }
+	Angle<T>& operator*=(const std::int32_t& scale) { *this = *this * scale; return *this; }
+
+	bool operator==(const Angle<T>& rhs) const { return _data == rhs._data; }
+	bool operator!=(const Angle<T>& rhs) const { return _data != rhs._data; }
+
+private:
+	/*!
+		The templated integer number representing the angle
+	*/
+	T _data = 0;
+};
+
+template <typename T>
+template <typename U, std::int8_t G>
+Angle<T>::Angle(const FixedPoint<U, G>& radians)
+{
+	static_assert(sizeof(U) <= 4, "The radians are limited to 32 bit fixed point numbers");
+
+	std::int64_t scaled = static_cast<std::int64_t>(radians.raw()) * RADIANS_TO_ANGLE;
+	_data = static_cast<T>(static_cast<UT>(scaled >> (G + 33 - N)));
+}
+
+template <typename T>
+Angle<T> Angle<T>::createAngle(T data)
+{
+	Angle<T> angle;
+	angle._data = data;
+	return angle;
+}
+
+template <typename T>
+template <typename U, std::int8_t G>
+FixedPoint<U, G> Angle<T>::toRadians() const
+{
+	/* An unsigned 32 bit angle times the 32 bit scale needs 64 bits of magnitude */
+	__int128 scaled = static_cast<__int128>(_data) * ANGLE_TO_RADIANS;
+	return FixedPoint<U, G>::createFixedPoint(static_cast<U>(scaled >> (29 + N - G)));
+}
+
+template <typename T>
+template <typename U, std::int8_t G>
+FixedPoint<U, G> Angle<T>::sin() const
+{
+	static const int SHIFT = N > SineTable::BITS ? N - SineTable::BITS : 0;
+	static const int WIDEN = N > SineTable::BITS ? 0 : SineTable::BITS - N;
+
+	UT angle = static_cast<UT>(_data);
+	std::uint32_t index = (std::uint32_t(angle) >> SHIFT) << WIDEN;
+	std::int64_t fraction = static_cast<std::int64_t>(angle) & ((std::int64_t(1) << SHIFT) - 1);
+
+	std::int64_t a = SineTable::VALUES[index];
+	std::int64_t b = SineTable::VALUES[index + 1];
+	std::int64_t value = a + (((b - a) * fraction) >> SHIFT);
+
+	return FixedPoint<U, G>::createFixedPoint(FixedPoint<U, G>::template convertType<std::int64_t, U>(value, G - SineTable::FRACTION));
+}
+
+template <typename T>
+template <typename U, std::int8_t G>
+FixedPoint<U, G> Angle<T>::cos() const
+{
+	return (*this + createAngle(static_cast<T>(UT(1) << (N - 2)))).template sin<U, G>();
+}
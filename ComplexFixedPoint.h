@@ -0,0 +1,331 @@
+/*!
+ *  \file ComplexFixedPoint.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+#include <type_traits>
+
+/*!
+	\class ComplexFixedPoint
+	\brief Templated class to handle complex Fixed Point arithmetic
+	\details The real and imaginary parts are stored interleaved (real first) so that an array of
+				ComplexFixedPoint has the same layout as an array of I/Q sample pairs. Products are
+				formed at full precision in the wide type and rescaled once per result component.
+	\tparam T The signed integer type of each component. This is limited to the 8, 16, and 32 bit options.
+	\tparam F The number of fractional bits of each component
+*/
+template <typename T, std::int8_t F>
+class ComplexFixedPoint
+{
+	static_assert(std::numeric_limits<T>::is_signed, "The Base T of a complex Fixed Point must be signed");
+	static_assert(sizeof(T) <= 4, "The Base T of a complex Fixed Point is limited to 32 bits");
+
+	/*! Integer type able to hold the product of two components */
+	typedef typename WideTypeSelector<T>::Type W;
+
+	/*! Unsigned counterpart of W, in which sums of two products wrap without overflowing */
+	typedef typename std::make_unsigned<W>::type U;
+
+public:
+	/*!
+		\brief Default constructor.
+	*/
+	ComplexFixedPoint() = default;
+
+	/*!
+		\brief Parameterised constructor. Builds the complex number from its two components.
+		\param real The real component
+		\param imag The imaginary component
+	*/
+	ComplexFixedPoint(const FixedPoint<T, F>& real, const FixedPoint<T, F>& imag)
+			: _real(real), _imag(imag)
+	{}
+
+	/*!
+		\brief Parameterised constructor. Converts two doubles to the fixed point format.
+		\param real The real component to convert
+		\param imag The imaginary component to convert
+	*/
+	ComplexFixedPoint(const double& real, const double& imag)
+			: _real(real), _imag(imag)
+	{}
+
+	FixedPoint<T, F> real() const { return _real; }
+	void real(const FixedPoint<T, F>& value) { _real = value; }
+
+	FixedPoint<T, F> imag() const { return _imag; }
+	void imag(const FixedPoint<T, F>& value) { _imag = value; }
+
+	/*!
+		\brief Creates a new complex fixed point from the raw data of both components
+		\param real The raw data of the real component
+		\param imag The raw data of the imaginary component
+		\returns A complex fixed point number with the raw data as the parameters
+	*/
+	static ComplexFixedPoint<T, F> createComplexFixedPoint(T real, T imag);
+
+	/*!
+		\brief Get the complex conjugate
+		\returns The complex number with the imaginary component negated
+	*/
+	ComplexFixedPoint<T, F> conj() const;
+
+	/*!
+		\brief Calculate the squared magnitude, re^2 + im^2, summed at full precision and rescaled once. The sum
+				is taken in the unsigned counterpart of the wide type, which holds it even with both components
+				at the lowest value.
+		\returns The squared magnitude in the same fixed point format as the components
+	*/
+	FixedPoint<T, F> magnitudeSquared() const;
+
+	ComplexFixedPoint<T, F> operator+(const ComplexFixedPoint<T, F>& rhs) const;
+	ComplexFixedPoint<T, F>& operator+=(const ComplexFixedPoint<T, F>& rhs);
+
+	ComplexFixedPoint<T, F> operator-(const ComplexFixedPoint<T, F>& rhs) const;
+	ComplexFixedPoint<T, F>& operator-=(const ComplexFixedPoint<T, F>& rhs);
+
+	/*!
+		\brief Full precision complex multiply. Each output component is the sum of two products formed in
+				the wide type and rescaled once. The sums are taken in the unsigned counterpart of the wide type,
+				so the one case that exceeds it, both components of both operands holding the lowest value,
+				wraps rather than overflowing.
+	*/
+	ComplexFixedPoint<T, F> operator*(const ComplexFixedPoint<T, F>& rhs) const;
+	ComplexFixedPoint<T, F>& operator*=(const ComplexFixedPoint<T, F>& rhs);
+
+	/*!
+		\brief Complex multiply using three real multiplications instead of four (Gauss's method)
+		\details Intermediate sums need two more bits than the wide type provides, so the products are formed in
+					the type twice as wide again. The results are bit identical to operator*. Limited to 8 and 16
+					bit components.
+		\param rhs The complex number to multiply by
+		\returns The product of this and rhs
+	*/
+	ComplexFixedPoint<T, F> gaussMultiply(const ComplexFixedPoint<T, F>& rhs) const;
+
+	/*!
+		\brief Multiply by the conjugate of rhs, this * conj(rhs), at full precision
+		\param rhs The complex number whose conjugate is multiplied by
+		\returns The product of this and the conjugate of rhs
+	*/
+	ComplexFixedPoint<T, F> conjugateMultiply(const ComplexFixedPoint<T, F>& rhs) const;
+
+	bool operator==(const ComplexFixedPoint<T, F>& rhs) const;
+	bool operator!=(const ComplexFixedPoint<T, F>& rhs) const;
+
+private:
+	/*!
+		The real component, stored first to keep the interleaved I/Q layout
+	*/
+	FixedPoint<T, F> _real;
+
+	/*!
+		The imaginary component
+	*/
+	FixedPoint<T, F> _imag;
+};
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::createComplexFixedPoint(T real, T imag)
+{
+	return ComplexFixedPoint<T, F>(FixedPoint<T, F>::createFixedPoint(real), FixedPoint<T, F>::createFixedPoint(imag));
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::conj() const
+{
+	return createComplexFixedPoint(_real.raw(), static_cast<T>(-_imag.raw()));
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> ComplexFixedPoint<T, F>::magnitudeSquared() const
+{
+	W real = _real.raw();
+	W imag = _imag.raw();
+
+	return FixedPoint<T, F>::createFixedPoint(static_cast<T>((static_cast<U>(real * real) + static_cast<U>(imag * imag)) >> F));
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::operator+(const ComplexFixedPoint<T, F>& rhs) const
+{
+	return createComplexFixedPoint(static_cast<T>(_real.raw() + rhs._real.raw()),
+								   static_cast<T>(_imag.raw() + rhs._imag.raw()));
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F>& ComplexFixedPoint<T, F>::operator+=(const ComplexFixedPoint<T, F>& rhs)
+{
+	*this = *this + rhs;
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::operator-(const ComplexFixedPoint<T, F>& rhs) const
+{
+	return createComplexFixedPoint(static_cast<T>(_real.raw() - rhs._real.raw()),
+								   static_cast<T>(_imag.raw() - rhs._imag.raw()));
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F>& ComplexFixedPoint<T, F>::operator-=(const ComplexFixedPoint<T, F>& rhs)
+{
+	*this = *this - rhs;
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::operator*(const ComplexFixedPoint<T, F>& rhs) const
+{
+	W a = _real.raw();
+	W b = _imag.raw();
+	W c = rhs._real.raw();
+	W d = rhs._imag.raw();
+
+	W real = static_cast<W>(static_cast<U>(a * c) - static_cast<U>(b * d));
+	W imag = static_cast<W>(static_cast<U>(a * d) + static_cast<U>(b * c));
+
+	return createComplexFixedPoint(static_cast<T>(real >> F), static_cast<T>(imag >> F));
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F>& ComplexFixedPoint<T, F>::operator*=(const ComplexFixedPoint<T, F>& rhs)
+{
+	*this = *this * rhs;
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::gaussMultiply(const ComplexFixedPoint<T, F>& rhs) const
+{
+	static_assert(sizeof(T) <= 2, "The three multiply form is limited to 8 and 16 bit components");
+	typedef typename WideTypeSelector<W>::Type V;
+
+	V a = _real.raw();
+	V b = _imag.raw();
+	V c = rhs._real.raw();
+	V d = rhs._imag.raw();
+
+	V k1 = c * (a + b);
+	V k2 = a * (d - c);
+	V k3 = b * (c + d);
+
+	return createComplexFixedPoint(static_cast<T>((k1 - k3) >> F), static_cast<T>((k1 + k2) >> F));
+}
+
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> ComplexFixedPoint<T, F>::conjugateMultiply(const ComplexFixedPoint<T, F>& rhs) const
+{
+	W a = _real.raw();
+	W b = _imag.raw();
+	W c = rhs._real.raw();
+	W d = rhs._imag.raw();
+
+	W real = static_cast<W>(static_cast<U>(a * c) + static_cast<U>(b * d));
+	W imag = static_cast<W>(static_cast<U>(b * c) - static_cast<U>(a * d));
+
+	return createComplexFixedPoint(static_cast<T>(real >> F), static_cast<T>(imag >> F));
+}
+
+template <typename T, std::int8_t F>
+bool ComplexFixedPoint<T, F>::operator==(const ComplexFixedPoint<T, F>& rhs) const
+{
+	return _real.raw() == rhs._real.raw() && _imag.raw() == rhs._imag.raw();
+}
+
+template <typename T, std::int8_t F>
+bool ComplexFixedPoint<T, F>::operator!=(const ComplexFixedPoint<T, F>& rhs) const
+{
+	return !(*this == rhs);
+}
+
+/*
+	Batch kernels. These operate on contiguous arrays with no aliasing between the inputs and the output and are
+	written as straight line loops over the raw component data so the compiler can vectorise them.
+*/
+
+/*!
+	\brief Element wise full precision complex multiply, out[i] = a[i] * b[i]
+	\param a The first input array
+	\param b The second input array
+	\param out The output array, which may not overlap either input
+	\param count The number of complex elements
+*/
+template <typename T, std::int8_t F>
+void complexMultiply(const ComplexFixedPoint<T, F>* a, const ComplexFixedPoint<T, F>* b,
+					 ComplexFixedPoint<T, F>* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = a[i] * b[i];
+	}
+}
+
+/*!
+	\brief Element wise full precision conjugate multiply, out[i] = a[i] * conj(b[i])
+	\param a The first input array
+	\param b The array whose conjugates are multiplied by
+	\param out The output array, which may not overlap either input
+	\param count The number of complex elements
+*/
+template <typename T, std::int8_t F>
+void complexConjugateMultiply(const ComplexFixedPoint<T, F>* a, const ComplexFixedPoint<T, F>* b,
+							  ComplexFixedPoint<T, F>* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = a[i].conjugateMultiply(b[i]);
+	}
+}
+
+/*!
+	\brief Element wise squared magnitude, out[i] = |in[i]|^2
+	\param in The input array
+	\param out The output array
+	\param count The number of complex elements
+*/
+template <typename T, std::int8_t F>
+void complexMagnitudeSquared(const ComplexFixedPoint<T, F>* in, FixedPoint<T, F>* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = in[i].magnitudeSquared();
+	}
+}
+
+/*!
+	\brief Conjugate multiply accumulate, the sum of a[i] * conj(b[i]) over the arrays
+	\details The products are accumulated unscaled and the sum is rescaled once at the end, so no precision is
+				lost per element. Components of up to 16 bits accumulate in 64 bits and 32 bit components in 128
+				bits, so count must be below 2^31 or 2^63 respectively.
+	\param a The first input array
+	\param b The array whose conjugates are multiplied by
+	\param count The number of complex elements
+	\returns The rescaled sum
+*/
+template <typename T, std::int8_t F>
+ComplexFixedPoint<T, F> complexConjugateDot(const ComplexFixedPoint<T, F>* a, const ComplexFixedPoint<T, F>* b,
+											std::size_t count)
+{
+	typedef typename std::conditional<sizeof(T) <= 2, std::int64_t, __int128>::type A;
+
+	A real = 0;
+	A imag = 0;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		A ar = a[i].real().raw();
+		A ai = a[i].imag().raw();
+		A br = b[i].real().raw();
+		A bi = b[i].imag().raw();
+
+		real += ar * br + ai * bi;
+		imag += ai * br - ar * bi;
+	}
+
+	return ComplexFixedPoint<T, F>::createComplexFixedPoint(static_cast<T>(real >> F), static_cast<T>(imag >> F));
+}
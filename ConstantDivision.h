@@ -0,0 +1,152 @@
+/*!
+ *  \file ConstantDivision.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+
+/*!
+	\brief Multiplier and shift replacing unsigned division by a constant, after Granlund and Montgomery
+	\details With l = ceil(log2(D)) and m = ceil(2^(Bits + l) / D), floor(n / D) equals floor(n * m / 2^(Bits + l))
+				for every n below 2^Bits. The multiplier m needs Bits + 1 bits, so only its low Bits bits are
+				stored and the top bit is added back as n, which keeps every intermediate within 64 bits for
+				numerators of up to 32 bits and within 128 bits beyond that.
+	\tparam D The divisor
+	\tparam Bits The number of bits of the numerators, at most 63
+*/
+template <std::uint64_t D, int Bits>
+struct DivisionMagic
+{
+	static_assert(D > 0, "Division by zero");
+	static_assert(Bits > 0 && Bits <= 63, "Numerators must have between 1 and 63 bits");
+
+	/*! l, the number of bits needed to hold D - 1 */
+	static constexpr int SHIFT = []()
+	{
+		int shift = 0;
+		while (shift < 64 && (std::uint64_t(1) << shift) < D)
+		{
+			++shift;
+		}
+
+		return shift;
+	}();
+
+	/*! m - 2^Bits, which is below 2^Bits */
+	static constexpr std::uint64_t MULTIPLIER = static_cast<std::uint64_t>(
+		((static_cast<unsigned __int128>(1) << Bits) * ((static_cast<unsigned __int128>(1) << SHIFT) - D) + D - 1) / D);
+
+	/*!
+		\brief Divide n, which must be below 2^Bits
+	*/
+	static std::uint64_t divide(std::uint64_t n)
+	{
+		if constexpr (Bits <= 32)
+		{
+			return (((n * MULTIPLIER) >> Bits) + n) >> SHIFT;
+		}
+		else
+		{
+			return ((static_cast<std::uint64_t>((static_cast<unsigned __int128>(n) * MULTIPLIER) >> Bits)) + n) >> SHIFT;
+		}
+	}
+};
+
+/*!
+	\brief Divide a signed or unsigned raw value by a constant, truncating toward zero like integer division
+	\tparam N The divisor
+	\tparam Bits The number of bits of the magnitude of the numerators
+*/
+template <std::int64_t N, int Bits, typename I>
+I divideRaw(I numerator)
+{
+	static_assert(N != 0, "Division by zero");
+
+	typedef DivisionMagic<static_cast<std::uint64_t>(N < 0 ? -N : N), Bits> Magic;
+
+	if constexpr (std::numeric_limits<I>::is_signed)
+	{
+		/* Divide the magnitude and restore the sign without branching, so batches vectorise */
+		std::int64_t value = static_cast<std::int64_t>(numerator);
+		std::int64_t sign = (value >> 63) ^ (N < 0 ? -1 : 0);
+		std::uint64_t magnitude = static_cast<std::uint64_t>(value < 0 ? -value : value);
+
+		std::int64_t quotient = static_cast<std::int64_t>(Magic::divide(magnitude));
+		return static_cast<I>((quotient ^ sign) - sign);
+	}
+	else
+	{
+		static_assert(N > 0, "Unsigned numbers can only be divided by a positive constant");
+		return static_cast<I>(Magic::divide(static_cast<std::uint64_t>(numerator)));
+	}
+}
+
+/*!
+	\brief Divides a fixed point number by an integer constant without a hardware divide
+	\details The result is exactly the raw value divided by N, truncated toward zero, for every input
+	\tparam N The divisor
+	\param x The fixed point number
+	\returns The quotient in the same format
+*/
+template <std::int64_t N, typename T, std::int8_t F>
+FixedPoint<T, F> divideBy(const FixedPoint<T, F>& x)
+{
+	static_assert(sizeof(T) <= 4, "Constant division supports a Base T of at most 32 bits");
+
+	return FixedPoint<T, F>::createFixedPoint(divideRaw<N, static_cast<int>(sizeof(T) * 8)>(x.raw()));
+}
+
+/*!
+	\brief Divides every element of an array by an integer constant
+	\param in The dividends
+	\param out The quotients, of at least count elements
+	\param count The number of elements
+*/
+template <std::int64_t N, typename T, std::int8_t F>
+void divideBy(const FixedPoint<T, F>* in, FixedPoint<T, F>* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = divideBy<N>(in[i]);
+	}
+}
+
+/*!
+	\brief Divides a fixed point number by a fixed point constant without a hardware divide
+	\details The divisor is the Fixed Point number with raw value Raw and G fractional bits, which can be
+				written with fixedPointRaw. The quotient is the raw value of x shifted up by G and divided by
+				Raw, truncated toward zero, exactly for every input.
+	\tparam Raw The raw value of the divisor
+	\tparam G The number of fractional bits of the divisor
+	\param x The fixed point number
+	\returns The quotient in the format of x
+*/
+template <std::int64_t Raw, std::int8_t G, typename T, std::int8_t F>
+FixedPoint<T, F> divideByFixed(const FixedPoint<T, F>& x)
+{
+	static_assert(sizeof(T) <= 4, "Constant division supports a Base T of at most 32 bits");
+	static_assert(sizeof(T) * 8 + G <= 63, "The shifted dividend must fit in 63 bits");
+
+	typedef typename std::conditional<std::numeric_limits<T>::is_signed, std::int64_t, std::uint64_t>::type I;
+
+	I numerator = static_cast<I>(static_cast<I>(x.raw()) * (I(1) << G));
+	return FixedPoint<T, F>::createFixedPoint(static_cast<T>(divideRaw<Raw, static_cast<int>(sizeof(T) * 8) + G>(numerator)));
+}
+
+/*!
+	\brief Divides every element of an array by a fixed point constant
+	\param in The dividends
+	\param out The quotients, of at least count elements
+	\param count The number of elements
+*/
+template <std::int64_t Raw, std::int8_t G, typename T, std::int8_t F>
+void divideByFixed(const FixedPoint<T, F>* in, FixedPoint<T, F>* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = divideByFixed<Raw, G>(in[i]);
+	}
+}
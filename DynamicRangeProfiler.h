@@ -0,0 +1,489 @@
+/*!
+ *  \file DynamicRangeProfiler.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*!
+	\class DynamicRangeProfiler
+	\brief Collects the observed range and quantisation error of named variables during a replay run and
+			recommends the narrowest Fixed Point format for each of them
+	\details Values are recorded by ProfiledFixedPoint. Each record holds the ideal value, calculated alongside
+				in double precision, and the error of the fixed point value against it.
+*/
+class DynamicRangeProfiler
+{
+public:
+	/*! Number of magnitude histogram buckets, one per power of two from 2^-64 to 2^63 */
+	static const int BUCKETS = 128;
+
+	/*!
+		\brief Statistics of one named variable
+	*/
+	struct VariableProfile
+	{
+		std::string name;
+
+		/*! Bits and fractional bits of the format the variable was recorded with */
+		int recordedBits = 0;
+		int recordedFraction = 0;
+		bool recordedSigned = false;
+
+		std::uint64_t count = 0;
+		double min = 0.0;
+		double max = 0.0;
+
+		/*! Number of ideal values that were exactly zero */
+		std::uint64_t zeros = 0;
+
+		/*! Count of ideal magnitudes in [2^(i - 64), 2^(i - 63)) for bucket i */
+		std::array<std::uint64_t, BUCKETS> histogram {};
+
+		double maxError = 0.0;
+		double sumError = 0.0;
+		double sumSquaredError = 0.0;
+	};
+
+	/*!
+		\brief The narrowest Fixed Point format found for one variable
+	*/
+	struct Recommendation
+	{
+		std::string name;
+
+		/*! Whether a format of 32 bits or less meets the error budget */
+		bool fits = false;
+		bool isSigned = false;
+
+		/*! Integer bits needed for the observed range plus the requested headroom, excluding the sign */
+		int integerBits = 0;
+
+		/*! Fewest fractional bits predicted to meet the error budget */
+		int minimumFraction = 0;
+
+		/*! Storage size in bits, 8, 16 or 32 */
+		int storageBits = 0;
+
+		/*! Fractional bits of the recommended format, the minimum plus any spare bits of the storage up to 31 */
+		int fraction = 0;
+
+		/*! The recommended type, for example FixedPoint<std::int16_t, 12> */
+		std::string type;
+	};
+
+	/*!
+		\brief Record a value of a variable
+		\param profile The profile of the variable
+		\param value The value held in fixed point
+		\param ideal The ideal value calculated in double precision
+	*/
+	static void record(VariableProfile& profile, double value, double ideal);
+
+	/*!
+		\brief Get the profile of a variable, creating it on first use
+		\param name The name of the variable
+		\param bits The number of bits of the recording format
+		\param fraction The number of fractional bits of the recording format
+		\param isSigned Whether the recording format is signed
+		\returns The profile, which stays valid until reset
+	*/
+	static VariableProfile& profile(const std::string& name, int bits, int fraction, bool isSigned);
+
+	/*!
+		\brief Get a copy of the profiles of every variable
+		\returns The profiles ordered by name
+	*/
+	static std::vector<VariableProfile> profiles();
+
+	/*!
+		\brief Recommend the narrowest format of every variable that meets the error budget
+		\details The error of a variable is taken to scale with its resolution, so the maximum error recorded
+					with F fractional bits predicts an error of maxError * 2^(F - G) with G bits. The prediction is
+					never less than the resolution 2^-G of a single truncation.
+		\param errorBudget The largest acceptable absolute error of every variable
+		\param headroomBits Integer bits added above the largest observed magnitude
+		\returns One recommendation per variable ordered by name
+	*/
+	static std::vector<Recommendation> recommend(double errorBudget, int headroomBits = 1);
+
+	/*!
+		\brief Write the profiles and recommendations as a table
+		\param stream The stream to write to
+		\param errorBudget The largest acceptable absolute error of every variable
+		\param headroomBits Integer bits added above the largest observed magnitude
+	*/
+	static void dump(std::ostream& stream, double errorBudget, int headroomBits = 1);
+
+	/*!
+		\brief Remove every profile. Any ProfiledFixedPoint still alive must not record afterwards.
+	*/
+	static void reset();
+
+private:
+	struct Registry
+	{
+		std::mutex mutex;
+		std::map<std::string, VariableProfile> profiles;
+	};
+
+	static Registry& registry()
+	{
+		static Registry registry;
+		return registry;
+	}
+};
+
+inline void DynamicRangeProfiler::record(VariableProfile& profile, double value, double ideal)
+{
+	std::lock_guard<std::mutex> lock(registry().mutex);
+
+	if (profile.count == 0 || ideal < profile.min)
+	{
+		profile.min = ideal;
+	}
+	if (profile.count == 0 || ideal > profile.max)
+	{
+		profile.max = ideal;
+	}
+	++profile.count;
+
+	if (ideal == 0.0)
+	{
+		++profile.zeros;
+	}
+	else
+	{
+		int exponent = static_cast<int>(std::floor(std::log2(std::fabs(ideal))));
+		int bucket = exponent + 64;
+		profile.histogram[bucket < 0 ? 0 : (bucket >= BUCKETS ? BUCKETS - 1 : bucket)]++;
+	}
+
+	double error = std::fabs(value - ideal);
+	profile.maxError = error > profile.maxError ? error : profile.maxError;
+	profile.sumError += error;
+	profile.sumSquaredError += error * error;
+}
+
+inline DynamicRangeProfiler::VariableProfile& DynamicRangeProfiler::profile(const std::string& name, int bits, int fraction, bool isSigned)
+{
+	std::lock_guard<std::mutex> lock(registry().mutex);
+
+	auto found = registry().profiles.find(name);
+	if (found != registry().profiles.end())
+	{
+		return found->second;
+	}
+
+	VariableProfile& created = registry().profiles[name];
+	created.name = name;
+	created.recordedBits = bits;
+	created.recordedFraction = fraction;
+	created.recordedSigned = isSigned;
+	return created;
+}
+
+inline std::vector<DynamicRangeProfiler::VariableProfile> DynamicRangeProfiler::profiles()
+{
+	std::lock_guard<std::mutex> lock(registry().mutex);
+
+	std::vector<VariableProfile> copies;
+	for (const auto& entry : registry().profiles)
+	{
+		copies.push_back(entry.second);
+	}
+
+	return copies;
+}
+
+inline std::vector<DynamicRangeProfiler::Recommendation> DynamicRangeProfiler::recommend(double errorBudget, int headroomBits)
+{
+	std::vector<Recommendation> recommendations;
+
+	for (const VariableProfile& profile : profiles())
+	{
+		Recommendation recommendation;
+		recommendation.name = profile.name;
+		recommendation.isSigned = profile.min < 0.0;
+
+		double magnitude = std::fmax(std::fabs(profile.min), std::fabs(profile.max));
+		int integer_bits = 0;
+		while (integer_bits < 64 && std::ldexp(1.0, integer_bits) <= magnitude)
+		{
+			++integer_bits;
+		}
+		recommendation.integerBits = integer_bits + headroomBits;
+
+		int fraction = 1;
+		while (fraction < 64 &&
+			   std::fmax(profile.maxError * std::ldexp(1.0, profile.recordedFraction - fraction), std::ldexp(1.0, -fraction)) > errorBudget)
+		{
+			++fraction;
+		}
+		recommendation.minimumFraction = fraction;
+
+		int bits = (recommendation.isSigned ? 1 : 0) + recommendation.integerBits + fraction;
+		recommendation.storageBits = bits <= 8 ? 8 : (bits <= 16 ? 16 : 32);
+		recommendation.fits = bits <= 32;
+
+		if (recommendation.fits)
+		{
+			/*
+			 * FixedPoint takes at most 31 fractional bits in 32 bit storage, so unsigned data below one leaves the top bit spare
+			 */
+			recommendation.fraction = std::min(recommendation.storageBits - (recommendation.isSigned ? 1 : 0) - recommendation.integerBits, 31);
+			recommendation.type = std::string("FixedPoint<std::") + (recommendation.isSigned ? "int" : "uint") +
+								  std::to_string(recommendation.storageBits) + "_t, " + std::to_string(recommendation.fraction) + ">";
+		}
+
+		recommendations.push_back(recommendation);
+	}
+
+	return recommendations;
+}
+
+inline void DynamicRangeProfiler::dump(std::ostream& stream, double errorBudget, int headroomBits)
+{
+	std::vector<VariableProfile> variables = profiles();
+	std::vector<Recommendation> recommendations = recommend(errorBudget, headroomBits);
+
+	stream << "Dynamic range profile - error budget " << errorBudget << std::endl;
+	for (std::size_t i = 0; i < variables.size(); ++i)
+	{
+		const VariableProfile& profile = variables[i];
+		const Recommendation& recommendation = recommendations[i];
+
+		stream << profile.name << " (" << profile.count << " values)" << std::endl
+			   << "    range: [" << profile.min << ", " << profile.max << "]"
+			   << "  max error: " << profile.maxError
+			   << "  rms error: " << (profile.count != 0 ? std::sqrt(profile.sumSquaredError / profile.count) : 0.0) << std::endl
+			   << "    recommended: " << (recommendation.fits ? recommendation.type : std::string("no format of 32 bits or less")) << std::endl;
+	}
+}
+
+inline void DynamicRangeProfiler::reset()
+{
+	std::lock_guard<std::mutex> lock(registry().mutex);
+	registry().profiles.clear();
+}
+
+/*!
+	\class ProfiledFixedPoint
+	\brief Drop in replacement for FixedPoint that records every value assigned to a named variable
+	\details Arithmetic is carried out by FixedPoint as usual, alongside the same arithmetic in double precision
+				giving the ideal value. Named variables record both whenever they are constructed or assigned,
+				results of expressions are unnamed and record nothing until they are assigned to a named variable.
+	\tparam T The integer type of the Fixed Point
+	\tparam F The number of fractional bits of the Fixed Point
+*/
+template <typename T, std::int8_t F>
+class ProfiledFixedPoint
+{
+public:
+	/*!
+		\brief Default constructor. The variable is unnamed and records nothing.
+	*/
+	ProfiledFixedPoint() = default;
+
+	/*!
+		\brief Parameterised constructor. Creates an unnamed variable from a double, as FixedPoint would.
+		\param value The double to convert
+	*/
+	explicit ProfiledFixedPoint(const double& value)
+			: _value(value), _ideal(value)
+	{}
+
+	/*!
+		\brief Parameterised constructor. Creates a named variable holding zero.
+		\param name The name the variable is profiled under
+	*/
+	explicit ProfiledFixedPoint(const std::string& name)
+			: _profile(&DynamicRangeProfiler::profile(name, sizeof(T) * 8, F, std::numeric_limits<T>::is_signed))
+	{}
+
+	/*!
+		\brief Parameterised constructor. Creates a named variable from a double and records it.
+		\param name The name the variable is profiled under
+		\param value The double to convert
+	*/
+	ProfiledFixedPoint(const std::string& name, const double& value)
+			: _value(value), _ideal(value),
+			  _profile(&DynamicRangeProfiler::profile(name, sizeof(T) * 8, F, std::numeric_limits<T>::is_signed))
+	{
+		record();
+	}
+
+	/*!
+		\brief Copy constructor. The copy takes the value but is unnamed.
+	*/
+	ProfiledFixedPoint(const ProfiledFixedPoint<T, F>& rhs)
+			: _value(rhs._value), _ideal(rhs._ideal)
+	{}
+
+	/*!
+		\brief Assignment. The variable keeps its name and records the new value.
+	*/
+	ProfiledFixedPoint<T, F>& operator=(const ProfiledFixedPoint<T, F>& rhs);
+
+	T raw() const { return _value.raw(); }
+	FixedPoint<T, F> value() const { return _value; }
+	double ideal() const { return _ideal; }
+
+	float toFloat() const { return _value.toFloat(); }
+	double toDouble() const { return _value.toDouble(); }
+
+	/*!
+		\brief Creates an unnamed variable from a fixed point number, taking its value as ideal
+		\param value The fixed point number
+		\returns The unnamed variable
+	*/
+	static ProfiledFixedPoint<T, F> createProfiledFixedPoint(const FixedPoint<T, F>& value);
+
+	template <typename U, std::int8_t G>
+	ProfiledFixedPoint<T, F> operator+(const ProfiledFixedPoint<U, G>& rhs) const;
+	template <typename U, std::int8_t G>
+	ProfiledFixedPoint<T, F>& operator+=(const ProfiledFixedPoint<U, G>& rhs);
+
+	template <typename U, std::int8_t G>
+	ProfiledFixedPoint<T, F> operator-(const ProfiledFixedPoint<U, G>& rhs) const;
+	template <typename U, std::int8_t G>
+	ProfiledFixedPoint<T, F>& operator-=(const ProfiledFixedPoint<U, G>& rhs);
+
+	template <typename U, std::int8_t G>
+	ProfiledFixedPoint<T, F> operator*(const ProfiledFixedPoint<U, G>& rhs) const;
+	template <typename U, std::int8_t G>
+	ProfiledFixedPoint<T, F>& operator*=(const ProfiledFixedPoint<U, G>& rhs);
+
+	template <typename U, std::int8_t G>
+	bool operator==(const ProfiledFixedPoint<U, G>& rhs) const { return _value == rhs.value(); }
+	template <typename U, std::int8_t G>
+	bool operator!=(const ProfiledFixedPoint<U, G>& rhs) const { return _value != rhs.value(); }
+	template <typename U, std::int8_t G>
+	bool operator<(const ProfiledFixedPoint<U, G>& rhs) const { return _value < rhs.value(); }
+	template <typename U, std::int8_t G>
+	bool operator>(const ProfiledFixedPoint<U, G>& rhs) const { return _value > rhs.value(); }
+	template <typename U, std::int8_t G>
+	bool operator<=(const ProfiledFixedPoint<U, G>& rhs) const { return _value <= rhs.value(); }
+	template <typename U, std::int8_t G>
+	bool operator>=(const ProfiledFixedPoint<U, G>& rhs) const { return _value >= rhs.value(); }
+
+private:
+	/*!
+		\brief Creates an unnamed variable from a fixed point value and its ideal value
+	*/
+	static ProfiledFixedPoint<T, F> create(const FixedPoint<T, F>& value, double ideal);
+
+	/*!
+		\brief Record the current value when the variable is named
+	*/
+	void record();
+
+	/*!
+		The fixed point value
+	*/
+	FixedPoint<T, F> _value;
+
+	/*!
+		The ideal value calculated in double precision
+	*/
+	double _ideal = 0.0;
+
+	/*!
+		The profile of a named variable, null when unnamed
+	*/
+	DynamicRangeProfiler::VariableProfile* _profile = nullptr;
+};
+
+template <typename T, std::int8_t F>
+ProfiledFixedPoint<T, F>& ProfiledFixedPoint<T, F>::operator=(const ProfiledFixedPoint<T, F>& rhs)
+{
+	_value = rhs._value;
+	_ideal = rhs._ideal;
+	record();
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+ProfiledFixedPoint<T, F> ProfiledFixedPoint<T, F>::createProfiledFixedPoint(const FixedPoint<T, F>& value)
+{
+	return create(value, value.toDouble());
+}
+
+template <typename T, std::int8_t F>
+ProfiledFixedPoint<T, F> ProfiledFixedPoint<T, F>::create(const FixedPoint<T, F>& value, double ideal)
+{
+	ProfiledFixedPoint<T, F> profiled;
+	profiled._value = value;
+	profiled._ideal = ideal;
+	return profiled;
+}
+
+template <typename T, std::int8_t F>
+void ProfiledFixedPoint<T, F>::record()
+{
+	if (_profile != nullptr)
+	{
+		DynamicRangeProfiler::record(*_profile, _value.toDouble(), _ideal);
+	}
+}
+
+template <typename T, std::int8_t F>
+template <typename U, std::int8_t G>
+ProfiledFixedPoint<T, F> ProfiledFixedPoint<T, F>::operator+(const ProfiledFixedPoint<U, G>& rhs) const
+{
+	return create(_value + rhs.value(), _ideal + rhs.ideal());
+}
+
+template <typename T, std::int8_t F>
+template <typename U, std::int8_t G>
+ProfiledFixedPoint<T, F>& ProfiledFixedPoint<T, F>::operator+=(const ProfiledFixedPoint<U, G>& rhs)
+{
+	_value += rhs.value();
+	_ideal += rhs.ideal();
+	record();
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+template <typename U, std::int8_t G>
+ProfiledFixedPoint<T, F> ProfiledFixedPoint<T, F>::operator-(const ProfiledFixedPoint<U, G>& rhs) const
+{
+	return create(_value - rhs.value(), _ideal - rhs.ideal());
+}
+
+template <typename T, std::int8_t F>
+template <typename U, std::int8_t G>
+ProfiledFixedPoint<T, F>& ProfiledFixedPoint<T, F>::operator-=(const ProfiledFixedPoint<U, G>& rhs)
+{
+	_value -= rhs.value();
+	_ideal -= rhs.ideal();
+	record();
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+template <typename U, std::int8_t G>
+ProfiledFixedPoint<T, F> ProfiledFixedPoint<T, F>::operator*(const ProfiledFixedPoint<U, G>& rhs) const
+{
+	return create(_value * rhs.value(), _ideal * rhs.ideal());
+}
+
+template <typename T, std::int8_t F>
+template <typename U, std::int8_t G>
+ProfiledFixedPoint<T, F>& ProfiledFixedPoint<T, F>::operator*=(const ProfiledFixedPoint<U, G>& rhs)
+{
+	_value *= rhs.value();
+	_ideal *= rhs.ideal();
+	record();
+	return *this;
+}
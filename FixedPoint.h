@@ -9,6 +9,28 @@
 #include <bitset>
 #include <iostream>
 #include <cmath>
+#include <type_traits>
+
+/*
+	Defining FIXEDPOINT_INSTRUMENTATION before including this file records overflows and truncations, see
+	FixedPointInstrumentation.h. Conversions record against the location of their caller, but operators can not
+	take it, so outside of a FIXEDPOINT_SITE() scope every operator event is keyed to the line of this file that
+	makes the check rather than to the calling code.
+*/
+#ifdef FIXEDPOINT_INSTRUMENTATION
+#include "FixedPointInstrumentation.h"
+#define FIXEDPOINT_INSTRUMENT(...) __VA_ARGS__
+#else
+/*!
+	\brief Empty stand in for std::source_location, so locations cost nothing when instrumentation is disabled
+*/
+struct FixedPointLocation
+{
+	static constexpr FixedPointLocation current() noexcept { return FixedPointLocation(); }
+};
+#define FIXEDPOINT_INSTRUMENT(...)
+#define FIXEDPOINT_SITE()
+#endif
 
 template <typename T>
 struct SignedSelector
@@ -32,6 +54,74 @@ template <> struct SizeTypeIncrement<std::uint8_t, std::uint8_t> { typedef std::
 template <> struct SizeTypeIncrement<std::int16_t, std::uint16_t> { typedef std::uint32_t Type; };
 template <> struct SizeTypeIncrement<std::uint32_t, std::uint32_t> { typedef std::uint32_t Type; };
 
+/*!
+	\brief Selects the integer type of twice the width of T, used to hold full precision products
+*/
+template <typename T>
+struct WideTypeSelector
+{
+	typedef std::int64_t Type;
+};
+template <> struct WideTypeSelector<std::int8_t> { typedef std::int16_t Type; };
+template <> struct WideTypeSelector<std::int16_t> { typedef std::int32_t Type; };
+template <> struct WideTypeSelector<std::int32_t> { typedef std::int64_t Type; };
+template <> struct WideTypeSelector<std::uint8_t> { typedef std::uint16_t Type; };
+template <> struct WideTypeSelector<std::uint16_t> { typedef std::uint32_t Type; };
+template <> struct WideTypeSelector<std::uint32_t> { typedef std::uint64_t Type; };
+
+/*!
+	\brief Selects the smallest integer type with at least the given number of bits
+	\tparam B The number of bits required, including the sign bit for signed types
+	\tparam S Whether the type is to be signed
+	\details Type is void when no integer type of 64 bits or less is wide enough
+*/
+template <int B, bool S>
+struct StorageSelector
+{
+	typedef typename std::conditional<B <= 8, std::int8_t,
+			typename std::conditional<B <= 16, std::int16_t,
+			typename std::conditional<B <= 32, std::int32_t,
+			typename std::conditional<B <= 64, std::int64_t, void>::type>::type>::type>::type Type;
+};
+template <int B>
+struct StorageSelector<B, false>
+{
+	typedef typename std::conditional<B <= 8, std::uint8_t,
+			typename std::conditional<B <= 16, std::uint16_t,
+			typename std::conditional<B <= 32, std::uint32_t,
+			typename std::conditional<B <= 64, std::uint64_t, void>::type>::type>::type>::type Type;
+};
+
+/*!
+	\brief Calculate 2^exponent exactly as a double
+*/
+constexpr double exactPower2(int exponent)
+{
+	double value = 1.0;
+
+	for (; exponent > 0; --exponent)
+	{
+		value *= 2.0;
+	}
+
+	for (; exponent < 0; ++exponent)
+	{
+		value *= 0.5;
+	}
+
+	return value;
+}
+
+/*!
+	\brief Calculate the raw value of a double in a Fixed Point format at compile time
+	\details Truncates toward zero like the double constructor, for use as a compile time constant
+*/
+template <typename T, std::int8_t F>
+constexpr T fixedPointRaw(double value)
+{
+	return static_cast<T>(value * exactPower2(F));
+}
+
 /*!
 	\class FixedPoint
 	\brief Templated class to handle Fixed Point arithmetic
@@ -43,14 +133,14 @@ template<typename T, std::int8_t F>
 class FixedPoint
 {
 	static_assert(std::is_integral<T>::value, "The Base T must be of an Integral type");
-	static_assert(F <= 31, "Fractional F may be not be larger than 31 bits");
+	static_assert(F <= 31 || (sizeof(T) == 8 && F <= 62), "Fractional F may be not be larger than 31 bits, or 62 bits with 64 bit storage");
 	static_assert(F > 0, "Fractional must be larger than zero");
 
 	/*! Boolean indicator if the fixed point is signed or not */
 	static const bool S = std::numeric_limits<T>::is_signed;
 
 	/*! Numeric value of one in the templated fixed point format */
-	static const T ONE = 1 << F;
+	static const T ONE = T(1) << F;
 
 public:
 	/*!
@@ -193,10 +283,12 @@ public:
 		\brief Converts the FixedPoint to a completely different type and resolution
 		\tparam U The new data type to convert the raw data to
 		\tparam G The new fractional amount to convert the new Fixed point to
+		\param location The location of the caller, recorded against any overflow or truncation when
+					FIXEDPOINT_INSTRUMENTATION is defined
 		\returns A new FixedPoint number of base data type U and fractional amount G
 	*/
 	template <typename U, std::int8_t G>
-	FixedPoint<U, G> convert() const;
+	FixedPoint<U, G> convert(const FixedPointLocation& location = FixedPointLocation::current()) const;
 
 	/*!
 		\brief Creates a a new fixed point object with a value corresponding to the raw data to be stored
@@ -214,10 +306,12 @@ public:
 		\tparam J The final data type that the data will be converted to
 		\param initial
 		\param shift
+		\param location The location of the caller, recorded against any overflow or truncation when
+					FIXEDPOINT_INSTRUMENTATION is defined
 		\return
 	*/
 	template <typename I, typename J>
-	J static convertType(const I& initial, std::int8_t shift);
+	J static convertType(const I& initial, std::int8_t shift, const FixedPointLocation& location = FixedPointLocation::current());
 
 private:
 	/*!
@@ -285,6 +379,7 @@ FixedPoint<T, F> FixedPoint<T, F>::operator+(const FixedPoint<U, G>& rhs) const
 {
 	if (std::is_same<T, U>::value)
 	{
+		FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkSum<T>(_data, rhs.raw(), FixedPointLocation::current()));
 		return FixedPoint<T, F>::createFixedPoint(this->_data + rhs.raw());
 	}
 
@@ -303,10 +398,12 @@ FixedPoint<T, F>& FixedPoint<T, F>::operator+=(const FixedPoint<U, G>& rhs)
 {
 	if (std::is_same<T, U>::value)
 	{
+		FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkSum<T>(_data, rhs.raw(), FixedPointLocation::current()));
 		_data += rhs._data;
 		return *this;
 	}
 
+	FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkSum<T>(_data, rhs.template convert<T, F>().raw(), FixedPointLocation::current()));
 	_data += rhs.template convert<T, F>().raw();
 	return *this;
 }
@@ -317,6 +414,7 @@ FixedPoint<T, F> FixedPoint<T, F>::operator-(const FixedPoint<U, G>& rhs) const
 {
 	if (std::is_same<T,U>::value)
 	{
+		FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkDifference<T>(_data, rhs.raw(), FixedPointLocation::current()));
 		return FixedPoint<T, F>::createFixedPoint(this->_data - rhs.raw());
 	}
 
@@ -335,10 +433,12 @@ FixedPoint<T, F>& FixedPoint<T, F>::operator-=(const FixedPoint<U, G>& rhs)
 {
 	if (std::is_same<T, U>::value)
 	{
+		FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkDifference<T>(_data, rhs.raw(), FixedPointLocation::current()));
 		_data -= rhs._data;
 		return *this;
 	}
 
+	FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkDifference<T>(_data, rhs.template convert<T, F>().raw(), FixedPointLocation::current()));
 	_data -= rhs.template convert<T, F>().raw();
 	return *this;
 }
@@ -350,6 +450,9 @@ FixedPoint<T, F> FixedPoint<T, F>::operator*(const FixedPoint<U, G>& rhs) const
 	static const std::int8_t H = F + G;
 	typedef typename SizeTypeIncrement<T, T>::Type V;
 
+	/* The conversion below records overflows, unless the product has already wrapped within V */
+	FIXEDPOINT_INSTRUMENT(if (sizeof(V) < sizeof(T) + sizeof(U)) { FixedPointInstrumentation::checkProduct<T>(_data, rhs.raw(), G, FixedPointLocation::current()); });
+
 	FixedPoint<V, H> a;
 	a.raw(V(this->_data));
 
@@ -368,6 +471,9 @@ FixedPoint<T, F>& FixedPoint<T, F>::operator*=(const FixedPoint<U, G>& rhs)
 	static const std::int8_t H = F + G;
 	typedef typename SizeTypeIncrement<T, U>::Type V;
 
+	/* The conversion below records overflows, unless the product has already wrapped within V */
+	FIXEDPOINT_INSTRUMENT(if (sizeof(V) < sizeof(T) + sizeof(U)) { FixedPointInstrumentation::checkProduct<T>(_data, rhs.raw(), G, FixedPointLocation::current()); });
+
 	FixedPoint<V, H> a;
 	a.raw(V(this->_data));
 	FixedPoint<V, H> b;
@@ -380,16 +486,18 @@ FixedPoint<T, F>& FixedPoint<T, F>::operator*=(const FixedPoint<U, G>& rhs)
 
 template <typename T, std::int8_t F>
 template <typename U, std::int8_t G>
-FixedPoint<U, G> FixedPoint<T, F>::convert() const
+FixedPoint<U, G> FixedPoint<T, F>::convert(const FixedPointLocation& location) const
 {
 	std::int8_t fractional = G - F;
-	return FixedPoint<U, G>::createFixedPoint(FixedPoint<T, F>::convertType<T, U>(_data, fractional));
+	return FixedPoint<U, G>::createFixedPoint(FixedPoint<T, F>::convertType<T, U>(_data, fractional, location));
 }
 
 template <typename T, std::int8_t F>
 template <typename I, typename J>
-J FixedPoint<T, F>::convertType(const I& initial, std::int8_t shift)
+J FixedPoint<T, F>::convertType(const I& initial, std::int8_t shift, [[maybe_unused]] const FixedPointLocation& location)
 {
+	FIXEDPOINT_INSTRUMENT(FixedPointInstrumentation::checkShift<J>(initial, shift, location));
+
 	if (shift > 0)
 	{
 		J intermediate = static_cast<J>(initial);
@@ -474,6 +582,95 @@ bool FixedPoint<T, F>::operator>=(const FixedPoint<U, G>& rhs) const
 	return _data >= rhs.template convert<T, F>().raw();
 }
 
+/*!
+	\brief Result formats of the exact arithmetic functions
+	\details Each result has enough integer and fractional bits that no bits of either operand are discarded, and
+				is stored in the smallest integer type holding those bits. Sums keep the larger fractional amount
+				and gain one integer bit, products add the total and fractional bits of the operands. Differences
+				are formatted as sums but are always signed, so unsigned operands gain a sign bit.
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t G>
+struct ExactSelector
+{
+	static const bool S = std::numeric_limits<T>::is_signed || std::numeric_limits<U>::is_signed;
+
+	/*! Number of integer bits excluding any sign bit */
+	static const int T_MAGNITUDE = int(sizeof(T) * 8) - F - (std::numeric_limits<T>::is_signed ? 1 : 0);
+	static const int U_MAGNITUDE = int(sizeof(U) * 8) - G - (std::numeric_limits<U>::is_signed ? 1 : 0);
+
+	static const std::int8_t SUM_FRACTION = F > G ? F : G;
+	static const int SUM_BITS = (T_MAGNITUDE > U_MAGNITUDE ? T_MAGNITUDE : U_MAGNITUDE) + 1 + SUM_FRACTION + (S ? 1 : 0);
+
+	static const std::int8_t PRODUCT_FRACTION = F + G;
+	static const int PRODUCT_BITS = int(sizeof(T) * 8) + int(sizeof(U) * 8);
+
+	static const int DIFFERENCE_BITS = SUM_BITS + (S ? 0 : 1);
+
+	static_assert(SUM_BITS <= 64, "The exact sum needs more than 64 bits");
+
+	typedef FixedPoint<typename StorageSelector<SUM_BITS, S>::Type, SUM_FRACTION> Sum;
+	typedef FixedPoint<typename StorageSelector<(DIFFERENCE_BITS <= 64 ? DIFFERENCE_BITS : 64), true>::Type, SUM_FRACTION> Difference;
+	typedef FixedPoint<typename StorageSelector<PRODUCT_BITS, S>::Type, PRODUCT_FRACTION> Product;
+};
+
+/*!
+	\brief Adds two fixed point numbers without losing any bits
+	\details The result format is chosen at compile time, for example Q3.5 + Q2.6 gives Q4.6 held in 16 bits. The
+				single quantisation back to a narrower format is left to the caller through convert.
+	\param lhs The first fixed point number
+	\param rhs The second fixed point number
+	\returns The exact sum
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t G>
+typename ExactSelector<T, F, U, G>::Sum addExact(const FixedPoint<T, F>& lhs, const FixedPoint<U, G>& rhs)
+{
+	typedef ExactSelector<T, F, U, G> E;
+	typedef decltype(typename E::Sum().raw()) V;
+
+	V lhs_raw = static_cast<V>(static_cast<V>(lhs.raw()) << (E::SUM_FRACTION - F));
+	V rhs_raw = static_cast<V>(static_cast<V>(rhs.raw()) << (E::SUM_FRACTION - G));
+
+	return E::Sum::createFixedPoint(static_cast<V>(lhs_raw + rhs_raw));
+}
+
+/*!
+	\brief Subtracts two fixed point numbers without losing any bits
+	\param lhs The fixed point number to subtract from
+	\param rhs The fixed point number to subtract
+	\returns The exact difference, in the format of addExact made signed
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t G>
+typename ExactSelector<T, F, U, G>::Difference subExact(const FixedPoint<T, F>& lhs, const FixedPoint<U, G>& rhs)
+{
+	typedef ExactSelector<T, F, U, G> E;
+	static_assert(E::DIFFERENCE_BITS <= 64, "The exact difference needs more than 64 bits");
+	typedef decltype(typename E::Difference().raw()) V;
+
+	V lhs_raw = static_cast<V>(static_cast<V>(lhs.raw()) << (E::SUM_FRACTION - F));
+	V rhs_raw = static_cast<V>(static_cast<V>(rhs.raw()) << (E::SUM_FRACTION - G));
+
+	return E::Difference::createFixedPoint(static_cast<V>(lhs_raw - rhs_raw));
+}
+
+/*!
+	\brief Multiplies two fixed point numbers without losing any bits
+	\details The result format is chosen at compile time, for example Q3.5 * Q2.6 gives Q5.11 held in 16 bits and
+				two 16 bit operands give a 32 bit product. The single quantisation back to a narrower format is
+				left to the caller through convert.
+	\param lhs The first fixed point number
+	\param rhs The second fixed point number
+	\returns The exact product
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t G>
+typename ExactSelector<T, F, U, G>::Product mulExact(const FixedPoint<T, F>& lhs, const FixedPoint<U, G>& rhs)
+{
+	typedef ExactSelector<T, F, U, G> E;
+	static_assert(E::PRODUCT_BITS <= 64, "The exact product needs more than 64 bits");
+	typedef decltype(typename E::Product().raw()) V;
+
+	return E::Product::createFixedPoint(static_cast<V>(static_cast<V>(lhs.raw()) * static_cast<V>(rhs.raw())));
+}
+
 namespace std
 {
 	template <class T, std::int8_t F>
@@ -500,9 +697,9 @@ namespace std
 		}
 
 		static constexpr bool is_specialized = true;
-		static constexpr int  digits = 0;
+		static constexpr int  digits = std::numeric_limits<T>::digits;
 		static constexpr int  digits10 = 0;
-		static constexpr bool is_signed = false;
+		static constexpr bool is_signed = std::numeric_limits<T>::is_signed;
 		static constexpr bool is_integer = false;
 		static constexpr bool is_exact = false;
 
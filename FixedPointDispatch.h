@@ -0,0 +1,298 @@
+/*!
+ *  \file FixedPointDispatch.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define FIXEDPOINT_DISPATCH_X86 1
+#define FIXEDPOINT_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FIXEDPOINT_DISPATCH_X86 0
+#define FIXEDPOINT_TARGET(isa)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FIXEDPOINT_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define FIXEDPOINT_ALWAYS_INLINE inline
+#endif
+
+/*!
+	\brief Instruction set levels the batch kernels are built for, in increasing order
+*/
+enum class IsaLevel
+{
+	BASELINE,
+	SSE42,
+	AVX2,
+	AVX512
+};
+
+/*!
+	\brief Name of an instruction set level, as accepted by the FIXEDPOINT_ISA environment variable
+*/
+inline const char* isaLevelName(IsaLevel level)
+{
+	switch (level)
+	{
+	case IsaLevel::SSE42: return "sse4.2";
+	case IsaLevel::AVX2: return "avx2";
+	case IsaLevel::AVX512: return "avx512";
+	default: return "baseline";
+	}
+}
+
+/*!
+	\brief Parse the name of an instruction set level
+	\param name The name of the level
+	\param level Set to the parsed level
+	\returns False if the name is not known
+*/
+inline bool parseIsaLevel(const char* name, IsaLevel& level)
+{
+	for (IsaLevel candidate : { IsaLevel::BASELINE, IsaLevel::SSE42, IsaLevel::AVX2, IsaLevel::AVX512 })
+	{
+		if (std::strcmp(name, isaLevelName(candidate)) == 0)
+		{
+			level = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*!
+	\brief Highest instruction set level supported by this processor
+*/
+inline IsaLevel detectIsaLevel()
+{
+#if FIXEDPOINT_DISPATCH_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+	{
+		return IsaLevel::AVX512;
+	}
+
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return IsaLevel::AVX2;
+	}
+
+	if (__builtin_cpu_supports("sse4.2"))
+	{
+		return IsaLevel::SSE42;
+	}
+#endif
+
+	return IsaLevel::BASELINE;
+}
+
+/*!
+	\brief Choose the instruction set level to run
+	\details An override can only lower the level, so forcing a level the processor lacks falls back to the
+				detected one rather than faulting. Unknown names are ignored.
+	\param override The requested level name, or null for none
+	\param detected The level supported by the processor
+*/
+inline IsaLevel selectIsaLevel(const char* override, IsaLevel detected)
+{
+	IsaLevel requested;
+	if (override != nullptr && parseIsaLevel(override, requested) && requested < detected)
+	{
+		return requested;
+	}
+
+	return detected;
+}
+
+/*!
+	\brief Instruction set level used by the dispatched kernels, chosen once from CPUID and FIXEDPOINT_ISA
+*/
+inline IsaLevel activeIsaLevel()
+{
+	static const IsaLevel level = selectIsaLevel(std::getenv("FIXEDPOINT_ISA"), detectIsaLevel());
+	return level;
+}
+
+/*!
+	\brief Portable bodies of the batch kernels, compiled once per instruction set level by the wrappers below
+	\details The bodies are plain loops over raw values which the compiler vectorises for the target of the
+				function they are inlined into when built with -O3 or -ftree-vectorize. All levels give bit
+				identical results.
+*/
+namespace FixedPointKernelBodies
+{
+	template <typename T, std::int8_t F>
+	FIXEDPOINT_ALWAYS_INLINE void add(const FixedPoint<T, F>* lhs, const FixedPoint<T, F>* rhs, FixedPoint<T, F>* out, std::size_t count)
+	{
+		typedef typename std::make_unsigned<T>::type U;
+
+		/* Wrap around through the unsigned type like the integer hardware does */
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = FixedPoint<T, F>::createFixedPoint(static_cast<T>(static_cast<U>(lhs[i].raw()) + static_cast<U>(rhs[i].raw())));
+		}
+	}
+
+	template <typename T, std::int8_t F>
+	FIXEDPOINT_ALWAYS_INLINE void multiply(const FixedPoint<T, F>* lhs, const FixedPoint<T, F>* rhs, FixedPoint<T, F>* out, std::size_t count)
+	{
+		typedef typename WideTypeSelector<T>::Type W;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			W product = static_cast<W>(lhs[i].raw()) * static_cast<W>(rhs[i].raw());
+			out[i] = FixedPoint<T, F>::createFixedPoint(static_cast<T>(product >> F));
+		}
+	}
+
+	template <typename T, std::int8_t F>
+	FIXEDPOINT_ALWAYS_INLINE void quantise(const double* in, FixedPoint<T, F>* out, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			out[i] = FixedPoint<T, F>(in[i]);
+		}
+	}
+
+	template <typename T, std::int8_t F>
+	FIXEDPOINT_ALWAYS_INLINE FixedPoint<T, F> dot(const FixedPoint<T, F>* lhs, const FixedPoint<T, F>* rhs, std::size_t count)
+	{
+		typedef typename WideTypeSelector<T>::Type W;
+		typedef typename std::conditional<sizeof(T) <= 2, std::int64_t, __int128>::type A;
+
+		A sum = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			sum += static_cast<W>(lhs[i].raw()) * static_cast<W>(rhs[i].raw());
+		}
+
+		return FixedPoint<T, F>::createFixedPoint(static_cast<T>(sum >> F));
+	}
+
+	template <typename T, std::int8_t F>
+	FIXEDPOINT_ALWAYS_INLINE void filter(const FixedPoint<T, F>* in, std::size_t count, const FixedPoint<T, F>* taps, std::size_t tap_count, FixedPoint<T, F>* out)
+	{
+		typedef typename WideTypeSelector<T>::Type W;
+		typedef typename std::conditional<sizeof(T) <= 2, std::int64_t, __int128>::type A;
+
+		for (std::size_t i = 0; i + tap_count <= count; ++i)
+		{
+			A sum = 0;
+			for (std::size_t k = 0; k < tap_count; ++k)
+			{
+				sum += static_cast<W>(taps[k].raw()) * static_cast<W>(in[i + tap_count - 1 - k].raw());
+			}
+
+			out[i] = FixedPoint<T, F>::createFixedPoint(static_cast<T>(sum >> F));
+		}
+	}
+}
+
+/*!
+	\class FixedPointKernels
+	\brief Table of batch kernels for one Fixed Point format, built for several instruction set levels
+	\details Every kernel is compiled for each level with the target attribute, so one binary carries them all,
+				and the table for the processor it runs on is chosen once on first use. Products are formed in the
+				wide type of T and sums of products in 64 bits, or 128 bits for 32 bit T, each rescaled once, so
+				the Base T is limited to 32 bits and sums can not overflow for counts below 2^31.
+	\tparam T The Base type of the Fixed Point numbers
+	\tparam F The number of fractional bits
+*/
+template <typename T, std::int8_t F>
+struct FixedPointKernels
+{
+	static_assert(sizeof(T) <= 4, "Batch kernels need a Base T of at most 32 bits");
+
+	typedef FixedPoint<T, F> value_type;
+
+	/*! Element wise operation writing count results to out */
+	typedef void (*Binary)(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count);
+
+	/*! Conversion of count doubles, truncating like the double constructor */
+	typedef void (*Quantise)(const double* in, value_type* out, std::size_t count);
+
+	/*! Sum of count products */
+	typedef value_type (*Dot)(const value_type* lhs, const value_type* rhs, std::size_t count);
+
+	/*! Finite impulse response filter writing the count - tap_count + 1 fully overlapped outputs */
+	typedef void (*Filter)(const value_type* in, std::size_t count, const value_type* taps, std::size_t tap_count, value_type* out);
+
+	IsaLevel level;
+	Binary add;
+	Binary multiply;
+	Quantise quantise;
+	Dot dot;
+	Filter filter;
+
+	/*!
+		\brief Kernels compiled for the given level, which the processor must support
+	*/
+	static FixedPointKernels<T, F> forLevel(IsaLevel level);
+
+	/*!
+		\brief Kernels for the active instruction set level
+	*/
+	static const FixedPointKernels<T, F>& get()
+	{
+		static const FixedPointKernels<T, F> kernels = forLevel(activeIsaLevel());
+		return kernels;
+	}
+
+private:
+	static void addBaseline(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::add(lhs, rhs, out, count); }
+	static void multiplyBaseline(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::multiply(lhs, rhs, out, count); }
+	static void quantiseBaseline(const double* in, value_type* out, std::size_t count) { FixedPointKernelBodies::quantise(in, out, count); }
+	static value_type dotBaseline(const value_type* lhs, const value_type* rhs, std::size_t count) { return FixedPointKernelBodies::dot(lhs, rhs, count); }
+	static void filterBaseline(const value_type* in, std::size_t count, const value_type* taps, std::size_t tap_count, value_type* out) { FixedPointKernelBodies::filter(in, count, taps, tap_count, out); }
+
+#if FIXEDPOINT_DISPATCH_X86
+	FIXEDPOINT_TARGET("sse4.2") static void addSse42(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::add(lhs, rhs, out, count); }
+	FIXEDPOINT_TARGET("sse4.2") static void multiplySse42(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::multiply(lhs, rhs, out, count); }
+	FIXEDPOINT_TARGET("sse4.2") static void quantiseSse42(const double* in, value_type* out, std::size_t count) { FixedPointKernelBodies::quantise(in, out, count); }
+	FIXEDPOINT_TARGET("sse4.2") static value_type dotSse42(const value_type* lhs, const value_type* rhs, std::size_t count) { return FixedPointKernelBodies::dot(lhs, rhs, count); }
+	FIXEDPOINT_TARGET("sse4.2") static void filterSse42(const value_type* in, std::size_t count, const value_type* taps, std::size_t tap_count, value_type* out) { FixedPointKernelBodies::filter(in, count, taps, tap_count, out); }
+
+	FIXEDPOINT_TARGET("avx2") static void addAvx2(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::add(lhs, rhs, out, count); }
+	FIXEDPOINT_TARGET("avx2") static void multiplyAvx2(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::multiply(lhs, rhs, out, count); }
+	FIXEDPOINT_TARGET("avx2") static void quantiseAvx2(const double* in, value_type* out, std::size_t count) { FixedPointKernelBodies::quantise(in, out, count); }
+	FIXEDPOINT_TARGET("avx2") static value_type dotAvx2(const value_type* lhs, const value_type* rhs, std::size_t count) { return FixedPointKernelBodies::dot(lhs, rhs, count); }
+	FIXEDPOINT_TARGET("avx2") static void filterAvx2(const value_type* in, std::size_t count, const value_type* taps, std::size_t tap_count, value_type* out) { FixedPointKernelBodies::filter(in, count, taps, tap_count, out); }
+
+	FIXEDPOINT_TARGET("avx512f,avx512bw") static void addAvx512(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::add(lhs, rhs, out, count); }
+	FIXEDPOINT_TARGET("avx512f,avx512bw") static void multiplyAvx512(const value_type* lhs, const value_type* rhs, value_type* out, std::size_t count) { FixedPointKernelBodies::multiply(lhs, rhs, out, count); }
+	FIXEDPOINT_TARGET("avx512f,avx512bw") static void quantiseAvx512(const double* in, value_type* out, std::size_t count) { FixedPointKernelBodies::quantise(in, out, count); }
+	FIXEDPOINT_TARGET("avx512f,avx512bw") static value_type dotAvx512(const value_type* lhs, const value_type* rhs, std::size_t count) { return FixedPointKernelBodies::dot(lhs, rhs, count); }
+	FIXEDPOINT_TARGET("avx512f,avx512bw") static void filterAvx512(const value_type* in, std::size_t count, const value_type* taps, std::size_t tap_count, value_type* out) { FixedPointKernelBodies::filter(in, count, taps, tap_count, out); }
+#endif
+};
+
+template <typename T, std::int8_t F>
+FixedPointKernels<T, F> FixedPointKernels<T, F>::forLevel(IsaLevel level)
+{
+#if FIXEDPOINT_DISPATCH_X86
+	switch (level)
+	{
+	case IsaLevel::AVX512:
+		return { IsaLevel::AVX512, &addAvx512, &multiplyAvx512, &quantiseAvx512, &dotAvx512, &filterAvx512 };
+	case IsaLevel::AVX2:
+		return { IsaLevel::AVX2, &addAvx2, &multiplyAvx2, &quantiseAvx2, &dotAvx2, &filterAvx2 };
+	case IsaLevel::SSE42:
+		return { IsaLevel::SSE42, &addSse42, &multiplySse42, &quantiseSse42, &dotSse42, &filterSse42 };
+	default:
+		break;
+	}
+#endif
+
+	return { IsaLevel::BASELINE, &addBaseline, &multiplyBaseline, &quantiseBaseline, &dotBaseline, &filterBaseline };
+}
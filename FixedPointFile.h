@@ -0,0 +1,408 @@
+/*!
+ *  \file FixedPointFile.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*!
+	\brief Fixed size header at the start of every Fixed Point file
+	\details The data follows in chunks, each starting on an ALIGNMENT byte boundary, and the chunk index is
+				written after the last chunk when the file is closed. An index offset of zero marks a file that
+				was never closed.
+*/
+struct FixedPointFileHeader
+{
+	static constexpr char MAGIC[8] = { 'F', 'X', 'P', 'A', 'R', 'R', 'A', 'Y' };
+	static constexpr std::uint32_t VERSION = 1;
+	static constexpr std::uint32_t ALIGNMENT = 64;
+	static constexpr std::uint8_t LITTLE_ENDIAN_ORDER = 1;
+	static constexpr std::uint8_t BIG_ENDIAN_ORDER = 2;
+
+	/*!
+		\brief Byte order of this platform, in the encoding used by the header
+	*/
+	static constexpr std::uint8_t nativeEndianness()
+	{
+		return std::endian::native == std::endian::little ? LITTLE_ENDIAN_ORDER : BIG_ENDIAN_ORDER;
+	}
+
+	char magic[8];
+	std::uint32_t version;
+	std::uint8_t endianness;
+	std::uint8_t isSigned;
+	std::uint8_t digits;
+	std::int8_t fraction;
+	std::uint32_t elementSize;
+	std::uint32_t alignment;
+	std::uint64_t chunkCount;
+	std::uint64_t indexOffset;
+	std::uint64_t elementCount;
+	std::uint8_t reserved[16];
+};
+
+static_assert(sizeof(FixedPointFileHeader) == 64, "The Fixed Point file header must be 64 bytes");
+
+/*!
+	\brief Entry of the chunk index, giving the byte offset and number of elements of one chunk
+*/
+struct FixedPointFileChunk
+{
+	std::uint64_t offset;
+	std::uint64_t count;
+};
+
+/*!
+	\class FixedPointFileWriter
+	\brief Streams arrays of Fixed Point numbers to a file one chunk at a time
+	\details Chunks are written as raw values in the byte order of this platform, so writing costs one copy and
+				no conversion. The header and chunk index are completed by close, which the destructor calls.
+	\tparam T The Base type of the Fixed Point numbers
+	\tparam F The number of fractional bits
+*/
+template <typename T, std::int8_t F>
+class FixedPointFileWriter
+{
+	static_assert(sizeof(FixedPoint<T, F>) == sizeof(T), "FixedPoint must have the size of its Base T");
+
+public:
+	/*!
+		\brief Parameterised constructor. Creates or truncates the file and writes a provisional header.
+		\param path The path of the file
+	*/
+	explicit FixedPointFileWriter(const std::string& path);
+
+	~FixedPointFileWriter();
+
+	FixedPointFileWriter(const FixedPointFileWriter&) = delete;
+	FixedPointFileWriter& operator=(const FixedPointFileWriter&) = delete;
+
+	/*!
+		\brief Append one chunk to the file
+		\param data The values of the chunk
+		\param count The number of values
+	*/
+	void append(const FixedPoint<T, F>* data, std::size_t count);
+
+	/*!
+		\brief Write the chunk index and the final header and close the file
+	*/
+	void close();
+
+private:
+	/*!
+		\brief Write zero bytes up to the next multiple of alignment
+	*/
+	void pad(std::uint64_t alignment);
+
+	void write(const void* data, std::size_t bytes);
+
+	std::ofstream _stream;
+	std::uint64_t _position = 0;
+	std::uint64_t _elements = 0;
+	std::vector<FixedPointFileChunk> _chunks;
+};
+
+template <typename T, std::int8_t F>
+FixedPointFileWriter<T, F>::FixedPointFileWriter(const std::string& path)
+		: _stream(path, std::ios::binary | std::ios::out | std::ios::trunc)
+{
+	if (!_stream)
+	{
+		throw std::runtime_error("Unable to create Fixed Point file " + path);
+	}
+
+	FixedPointFileHeader header = {};
+	write(&header, sizeof(header));
+}
+
+template <typename T, std::int8_t F>
+FixedPointFileWriter<T, F>::~FixedPointFileWriter()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+}
+
+template <typename T, std::int8_t F>
+void FixedPointFileWriter<T, F>::write(const void* data, std::size_t bytes)
+{
+	_stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+	if (!_stream)
+	{
+		throw std::runtime_error("Unable to write Fixed Point file");
+	}
+
+	_position += bytes;
+}
+
+template <typename T, std::int8_t F>
+void FixedPointFileWriter<T, F>::pad(std::uint64_t alignment)
+{
+	static const char zeros[FixedPointFileHeader::ALIGNMENT] = {};
+
+	std::uint64_t remainder = _position % alignment;
+	if (remainder != 0)
+	{
+		write(zeros, static_cast<std::size_t>(alignment - remainder));
+	}
+}
+
+template <typename T, std::int8_t F>
+void FixedPointFileWriter<T, F>::append(const FixedPoint<T, F>* data, std::size_t count)
+{
+	pad(FixedPointFileHeader::ALIGNMENT);
+
+	_chunks.push_back({ _position, count });
+	_elements += count;
+
+	write(data, count * sizeof(T));
+}
+
+template <typename T, std::int8_t F>
+void FixedPointFileWriter<T, F>::close()
+{
+	if (!_stream.is_open())
+	{
+		return;
+	}
+
+	pad(sizeof(FixedPointFileChunk));
+	std::uint64_t index_offset = _position;
+	write(_chunks.data(), _chunks.size() * sizeof(FixedPointFileChunk));
+
+	FixedPointFileHeader header = {};
+	std::memcpy(header.magic, FixedPointFileHeader::MAGIC, sizeof(header.magic));
+	header.version = FixedPointFileHeader::VERSION;
+	header.endianness = FixedPointFileHeader::nativeEndianness();
+	header.isSigned = std::numeric_limits<FixedPoint<T, F>>::is_signed;
+	header.digits = static_cast<std::uint8_t>(std::numeric_limits<FixedPoint<T, F>>::digits);
+	header.fraction = F;
+	header.elementSize = sizeof(T);
+	header.alignment = FixedPointFileHeader::ALIGNMENT;
+	header.chunkCount = _chunks.size();
+	header.indexOffset = index_offset;
+	header.elementCount = _elements;
+
+	_stream.seekp(0);
+	write(&header, sizeof(header));
+	_stream.close();
+}
+
+/*!
+	\class FixedPointFileReader
+	\brief Maps a Fixed Point file into memory and exposes its chunks without copying or parsing
+	\details Opening a file only checks the header and the chunk index, the data is paged in by the operating
+				system as it is touched. Chunks are returned as spans of FixedPoint numbers pointing straight
+				into the mapping, after checking that the requested format matches the one recorded in the file
+				through numeric_limits. Files written on a platform of the other byte order are rejected, since
+				their values can not be used in place.
+*/
+class FixedPointFileReader
+{
+public:
+	/*!
+		\brief Parameterised constructor. Maps the file and validates its header and chunk index.
+		\param path The path of the file
+	*/
+	explicit FixedPointFileReader(const std::string& path);
+
+	~FixedPointFileReader();
+
+	FixedPointFileReader(const FixedPointFileReader&) = delete;
+	FixedPointFileReader& operator=(const FixedPointFileReader&) = delete;
+
+	const FixedPointFileHeader& header() const { return *reinterpret_cast<const FixedPointFileHeader*>(_data); }
+
+	std::size_t chunks() const { return static_cast<std::size_t>(header().chunkCount); }
+
+	/*!
+		\brief Total number of elements over all chunks
+	*/
+	std::uint64_t size() const { return header().elementCount; }
+
+	/*!
+		\brief Whether the file holds values of type FixedPoint<T, F>
+	*/
+	template <typename T, std::int8_t F>
+	bool matches() const;
+
+	/*!
+		\brief View one chunk of the file in place
+		\param index The index of the chunk
+		\returns The values of the chunk, valid for as long as the reader
+	*/
+	template <typename T, std::int8_t F>
+	std::span<const FixedPoint<T, F>> chunk(std::size_t index) const;
+
+private:
+	const FixedPointFileChunk& entry(std::size_t index) const;
+
+	/*!
+		\brief Unmap and close the file and report the failure
+	*/
+	[[noreturn]] void fail(const std::string& message);
+
+	int _file = -1;
+	const std::uint8_t* _data = nullptr;
+	std::size_t _bytes = 0;
+};
+
+inline FixedPointFileReader::FixedPointFileReader(const std::string& path)
+{
+	_file = ::open(path.c_str(), O_RDONLY);
+	if (_file < 0)
+	{
+		throw std::runtime_error("Unable to open Fixed Point file " + path);
+	}
+
+	struct stat status;
+	if (::fstat(_file, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FixedPointFileHeader)))
+	{
+		fail("Fixed Point file is too short " + path);
+	}
+
+	_bytes = static_cast<std::size_t>(status.st_size);
+	void* mapping = ::mmap(nullptr, _bytes, PROT_READ, MAP_PRIVATE, _file, 0);
+	if (mapping == MAP_FAILED)
+	{
+		fail("Unable to map Fixed Point file " + path);
+	}
+	_data = static_cast<const std::uint8_t*>(mapping);
+
+	const FixedPointFileHeader& file_header = header();
+	if (std::memcmp(file_header.magic, FixedPointFileHeader::MAGIC, sizeof(file_header.magic)) != 0)
+	{
+		fail("Not a Fixed Point file " + path);
+	}
+
+	if (file_header.version != FixedPointFileHeader::VERSION)
+	{
+		fail("Unsupported Fixed Point file version " + std::to_string(file_header.version));
+	}
+
+	if (file_header.indexOffset == 0)
+	{
+		fail("Fixed Point file was not closed " + path);
+	}
+
+	if (file_header.elementSize != 1 && file_header.elementSize != 2 && file_header.elementSize != 4 && file_header.elementSize != 8)
+	{
+		fail("Unsupported Fixed Point element size " + std::to_string(file_header.elementSize));
+	}
+
+	if (file_header.alignment == 0 || file_header.alignment % file_header.elementSize != 0)
+	{
+		fail("Unsupported Fixed Point chunk alignment " + std::to_string(file_header.alignment));
+	}
+
+	if (file_header.indexOffset < sizeof(FixedPointFileHeader)
+			|| (file_header.indexOffset - sizeof(FixedPointFileHeader)) % file_header.elementSize != 0)
+	{
+		fail("Fixed Point file has a corrupt payload " + path);
+	}
+
+	if (file_header.indexOffset % sizeof(FixedPointFileChunk) != 0 || file_header.indexOffset > _bytes
+			|| file_header.chunkCount > (_bytes - file_header.indexOffset) / sizeof(FixedPointFileChunk))
+	{
+		fail("Fixed Point file has a corrupt chunk index " + path);
+	}
+
+	for (std::size_t i = 0; i < chunks(); ++i)
+	{
+		const FixedPointFileChunk& chunk_entry = entry(i);
+		if (chunk_entry.offset % file_header.alignment != 0 || chunk_entry.offset < sizeof(FixedPointFileHeader)
+				|| chunk_entry.offset > file_header.indexOffset
+				|| chunk_entry.count > (file_header.indexOffset - chunk_entry.offset) / file_header.elementSize)
+		{
+			fail("Fixed Point file has a corrupt chunk " + std::to_string(i));
+		}
+	}
+}
+
+inline FixedPointFileReader::~FixedPointFileReader()
+{
+	if (_data != nullptr)
+	{
+		::munmap(const_cast<std::uint8_t*>(_data), _bytes);
+	}
+
+	if (_file >= 0)
+	{
+		::close(_file);
+	}
+}
+
+inline void FixedPointFileReader::fail(const std::string& message)
+{
+	if (_data != nullptr)
+	{
+		::munmap(const_cast<std::uint8_t*>(_data), _bytes);
+		_data = nullptr;
+	}
+
+	::close(_file);
+	_file = -1;
+
+	throw std::runtime_error(message);
+}
+
+inline const FixedPointFileChunk& FixedPointFileReader::entry(std::size_t index) const
+{
+	return reinterpret_cast<const FixedPointFileChunk*>(_data + header().indexOffset)[index];
+}
+
+template <typename T, std::int8_t F>
+bool FixedPointFileReader::matches() const
+{
+	const FixedPointFileHeader& file_header = header();
+
+	return file_header.endianness == FixedPointFileHeader::nativeEndianness()
+		&& file_header.elementSize == sizeof(T)
+		&& static_cast<bool>(file_header.isSigned) == std::numeric_limits<FixedPoint<T, F>>::is_signed
+		&& file_header.digits == std::numeric_limits<FixedPoint<T, F>>::digits
+		&& file_header.fraction == F;
+}
+
+template <typename T, std::int8_t F>
+std::span<const FixedPoint<T, F>> FixedPointFileReader::chunk(std::size_t index) const
+{
+	static_assert(sizeof(FixedPoint<T, F>) == sizeof(T), "FixedPoint must have the size of its Base T");
+
+	if (!matches<T, F>())
+	{
+		const FixedPointFileHeader& file_header = header();
+		throw std::runtime_error("Fixed Point file holds " + std::string(file_header.isSigned ? "signed " : "unsigned ")
+			+ std::to_string(file_header.elementSize * 8) + " bit values with " + std::to_string(file_header.fraction)
+			+ " fractional bits");
+	}
+
+	if (index >= chunks())
+	{
+		throw std::out_of_range("Fixed Point file chunk " + std::to_string(index) + " out of range");
+	}
+
+	const FixedPointFileChunk& chunk_entry = entry(index);
+	return std::span<const FixedPoint<T, F>>(reinterpret_cast<const FixedPoint<T, F>*>(_data + chunk_entry.offset),
+		static_cast<std::size_t>(chunk_entry.count));
+}
@@ -0,0 +1,395 @@
+/*!
+ *  \file FixedPointImage.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*!
+	\class FixedPointImage
+	\brief Row major image of Fixed Point pixels
+	\tparam T The Base type of the pixels
+	\tparam F The number of fractional bits of the pixels
+*/
+template <typename T, std::int8_t F>
+class FixedPointImage
+{
+public:
+	typedef FixedPoint<T, F> value_type;
+
+	/*!
+		\brief Parameterised constructor. Creates an image with every pixel zero.
+	*/
+	FixedPointImage(std::size_t width = 0, std::size_t height = 0)
+			: _width(width), _height(height), _pixels(width * height)
+	{}
+
+	std::size_t width() const { return _width; }
+	std::size_t height() const { return _height; }
+
+	void resize(std::size_t width, std::size_t height)
+	{
+		_width = width;
+		_height = height;
+		_pixels.resize(width * height);
+	}
+
+	value_type* data() { return _pixels.data(); }
+	const value_type* data() const { return _pixels.data(); }
+
+	value_type* row(std::size_t y) { return _pixels.data() + y * _width; }
+	const value_type* row(std::size_t y) const { return _pixels.data() + y * _width; }
+
+	value_type& operator()(std::size_t x, std::size_t y) { return _pixels[y * _width + x]; }
+	const value_type& operator()(std::size_t x, std::size_t y) const { return _pixels[y * _width + x]; }
+
+private:
+	std::size_t _width;
+	std::size_t _height;
+	std::vector<value_type> _pixels;
+};
+
+/*!
+	\brief A W by H convolution kernel, centred on its middle coefficient
+	\tparam W The width, odd
+	\tparam H The height, odd
+	\tparam G The number of fractional bits of the coefficients
+	\tparam A The accumulator, which must hold the sum of every product of a pixel and a coefficient
+*/
+template <int W, int H, std::int8_t G, typename A = std::int64_t>
+struct ConvolutionKernel
+{
+	static_assert(W % 2 == 1 && H % 2 == 1, "Kernels must have odd sizes");
+
+	typedef A Accumulator;
+
+	static const int WIDTH = W;
+	static const int HEIGHT = H;
+
+	/*! Total fractional bits the accumulator gains */
+	static const int FRACTION = G;
+
+	/*! Raw coefficients, row major */
+	std::array<std::int32_t, W * H> coefficients;
+};
+
+/*!
+	\brief A separable kernel, the outer product of a vertical and a horizontal kernel
+	\details Applied as a horizontal pass into wide intermediates and a vertical pass over them, with a single
+				rescale at the end, so the result is exactly that of the equivalent W by H kernel. The accumulator
+				must hold the horizontal sums multiplied by the vertical coefficients.
+	\tparam W The width, odd
+	\tparam H The height, odd
+	\tparam G The number of fractional bits of the coefficients of each pass
+	\tparam A The accumulator
+*/
+template <int W, int H, std::int8_t G, typename A = std::int64_t>
+struct SeparableKernel
+{
+	static_assert(W % 2 == 1 && H % 2 == 1, "Kernels must have odd sizes");
+
+	typedef A Accumulator;
+
+	static const int WIDTH = W;
+	static const int HEIGHT = H;
+	static const int FRACTION = 2 * G;
+
+	std::array<std::int32_t, W> horizontal;
+	std::array<std::int32_t, H> vertical;
+};
+
+/*! Columns of the output computed per tile */
+inline constexpr std::size_t CONVOLUTION_TILE_WIDTH = 128;
+
+/*! Rows of the output computed per tile */
+inline constexpr std::size_t CONVOLUTION_TILE_HEIGHT = 32;
+
+/*!
+	\brief acc[x] += sum over k of in[x + k * step] * coefficients[k], for x below n
+	\details The taps are expanded from the index sequence, so they unroll completely and the loop over x is a plain
+				loop the compiler can vectorise.
+*/
+template <typename A, typename S, std::size_t... K>
+void accumulateTaps(A* acc, const S* in, std::size_t step, const std::int32_t* coefficients, std::size_t n, std::index_sequence<K...>)
+{
+	for (std::size_t x = 0; x < n; ++x)
+	{
+		acc[x] += ((static_cast<A>(in[x + K * step]) * coefficients[K]) + ...);
+	}
+}
+
+/*!
+	\brief Round the accumulators to nearest, remove Shift fractional bits and saturate into the output row
+	\details Saturation compares in 128 bits unless the accumulator is wider than the output, so the limits of
+				outputs as wide as the accumulator, or unsigned of the same size, are not wrapped.
+*/
+template <int Shift, typename A, typename U, std::int8_t H>
+void storeConvolution(const A* acc, FixedPoint<U, H>* out, std::size_t n)
+{
+	typedef typename std::conditional<(sizeof(U) < sizeof(A)), A, __int128>::type C;
+
+	for (std::size_t x = 0; x < n; ++x)
+	{
+		A value;
+		if constexpr (Shift > 0)
+		{
+			value = (acc[x] + (A(1) << (Shift - 1))) >> Shift;
+		}
+		else
+		{
+			value = acc[x] * (A(1) << -Shift);
+		}
+
+		C saturated = std::clamp<C>(value, static_cast<C>(std::numeric_limits<U>::min()), static_cast<C>(std::numeric_limits<U>::max()));
+		out[x] = FixedPoint<U, H>::createFixedPoint(static_cast<U>(saturated));
+	}
+}
+
+/*!
+	\brief Copy the raw pixels a tile needs, replicating the edges of the image
+	\param in The image
+	\param x0 The first column of the padded tile, which may be negative
+	\param y0 The first row of the padded tile, which may be negative
+	\param width The width of the padded tile
+	\param height The height of the padded tile
+	\param tile The raw pixels, row major
+*/
+template <typename T, std::int8_t F>
+void gatherTile(const FixedPointImage<T, F>& in, std::ptrdiff_t x0, std::ptrdiff_t y0, std::size_t width, std::size_t height, T* tile)
+{
+	const std::ptrdiff_t LAST_X = static_cast<std::ptrdiff_t>(in.width()) - 1;
+	const std::ptrdiff_t LAST_Y = static_cast<std::ptrdiff_t>(in.height()) - 1;
+
+	for (std::size_t py = 0; py < height; ++py)
+	{
+		const FixedPoint<T, F>* row = in.row(static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(y0 + static_cast<std::ptrdiff_t>(py), 0, LAST_Y)));
+		T* out = tile + py * width;
+
+		for (std::size_t px = 0; px < width; ++px)
+		{
+			out[px] = row[std::clamp<std::ptrdiff_t>(x0 + static_cast<std::ptrdiff_t>(px), 0, LAST_X)].raw();
+		}
+	}
+}
+
+/*!
+	\brief Run rows(first, last) over contiguous bands of rows on the given number of threads
+*/
+template <typename Rows>
+void runRowBands(std::size_t threads, std::size_t height, Rows rows)
+{
+	threads = std::max<std::size_t>(1, std::min(threads, height));
+
+	std::vector<std::thread> workers;
+	for (std::size_t t = 1; t < threads; ++t)
+	{
+		workers.emplace_back([&rows, t, threads, height]() { rows(height * t / threads, height * (t + 1) / threads); });
+	}
+
+	rows(0, height / threads);
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/*!
+	\brief Convolve an image with a kernel, replicating the edges
+	\details The image is processed in cache sized tiles, each gathered once with its border and convolved without
+				bounds checks. Products are summed in the accumulator of the kernel and rescaled once into the
+				output format with rounding to nearest and saturation. Bands of rows are split over threads, and
+				the result does not depend on the number of threads.
+	\param in The input image
+	\param out The output image, resized to the input
+	\param kernel The kernel
+	\param threads The number of threads
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t H, int KW, int KH, std::int8_t G, typename A>
+void convolve(const FixedPointImage<T, F>& in, FixedPointImage<U, H>& out, const ConvolutionKernel<KW, KH, G, A>& kernel, std::size_t threads = 1)
+{
+	const std::ptrdiff_t RX = KW / 2;
+	const std::ptrdiff_t RY = KH / 2;
+
+	out.resize(in.width(), in.height());
+	if (in.width() == 0)
+	{
+		return;
+	}
+
+	runRowBands(threads, in.height(), [&](std::size_t first, std::size_t last)
+	{
+		std::vector<T> tile((CONVOLUTION_TILE_WIDTH + KW - 1) * (CONVOLUTION_TILE_HEIGHT + KH - 1));
+		std::vector<A> acc(CONVOLUTION_TILE_WIDTH);
+
+		for (std::size_t ty = first; ty < last; ty += CONVOLUTION_TILE_HEIGHT)
+		{
+			std::size_t th = std::min(CONVOLUTION_TILE_HEIGHT, last - ty);
+
+			for (std::size_t tx = 0; tx < in.width(); tx += CONVOLUTION_TILE_WIDTH)
+			{
+				std::size_t tw = std::min(CONVOLUTION_TILE_WIDTH, in.width() - tx);
+				std::size_t pw = tw + KW - 1;
+				gatherTile(in, static_cast<std::ptrdiff_t>(tx) - RX, static_cast<std::ptrdiff_t>(ty) - RY, pw, th + KH - 1, tile.data());
+
+				for (std::size_t y = 0; y < th; ++y)
+				{
+					std::fill(acc.begin(), acc.begin() + tw, A(0));
+					for (int ky = 0; ky < KH; ++ky)
+					{
+						accumulateTaps(acc.data(), tile.data() + (y + ky) * pw, 1, kernel.coefficients.data() + ky * KW, tw, std::make_index_sequence<KW>());
+					}
+
+					storeConvolution<F + G - H>(acc.data(), out.row(ty + y) + tx, tw);
+				}
+			}
+		}
+	});
+}
+
+/*!
+	\brief Convolve an image with a separable kernel, replicating the edges
+	\details Each tile is gathered once, filtered horizontally into wide intermediates and then vertically, with
+				a single rescale into the output format. Exactly equal to convolving with the full kernel.
+	\param in The input image
+	\param out The output image, resized to the input
+	\param kernel The kernel
+	\param threads The number of threads
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t H, int KW, int KH, std::int8_t G, typename A>
+void convolve(const FixedPointImage<T, F>& in, FixedPointImage<U, H>& out, const SeparableKernel<KW, KH, G, A>& kernel, std::size_t threads = 1)
+{
+	const std::ptrdiff_t RX = KW / 2;
+	const std::ptrdiff_t RY = KH / 2;
+
+	out.resize(in.width(), in.height());
+	if (in.width() == 0)
+	{
+		return;
+	}
+
+	runRowBands(threads, in.height(), [&](std::size_t first, std::size_t last)
+	{
+		std::vector<T> tile((CONVOLUTION_TILE_WIDTH + KW - 1) * (CONVOLUTION_TILE_HEIGHT + KH - 1));
+		std::vector<A> middle(CONVOLUTION_TILE_WIDTH * (CONVOLUTION_TILE_HEIGHT + KH - 1));
+		std::vector<A> acc(CONVOLUTION_TILE_WIDTH);
+
+		for (std::size_t ty = first; ty < last; ty += CONVOLUTION_TILE_HEIGHT)
+		{
+			std::size_t th = std::min(CONVOLUTION_TILE_HEIGHT, last - ty);
+			std::size_t ph = th + KH - 1;
+
+			for (std::size_t tx = 0; tx < in.width(); tx += CONVOLUTION_TILE_WIDTH)
+			{
+				std::size_t tw = std::min(CONVOLUTION_TILE_WIDTH, in.width() - tx);
+				std::size_t pw = tw + KW - 1;
+				gatherTile(in, static_cast<std::ptrdiff_t>(tx) - RX, static_cast<std::ptrdiff_t>(ty) - RY, pw, ph, tile.data());
+
+				std::fill(middle.begin(), middle.begin() + ph * tw, A(0));
+				for (std::size_t py = 0; py < ph; ++py)
+				{
+					accumulateTaps(middle.data() + py * tw, tile.data() + py * pw, 1, kernel.horizontal.data(), tw, std::make_index_sequence<KW>());
+				}
+
+				for (std::size_t y = 0; y < th; ++y)
+				{
+					std::fill(acc.begin(), acc.begin() + tw, A(0));
+					accumulateTaps(acc.data(), middle.data() + y * tw, tw, kernel.vertical.data(), tw, std::make_index_sequence<KH>());
+
+					storeConvolution<F + 2 * G - H>(acc.data(), out.row(ty + y) + tx, tw);
+				}
+			}
+		}
+	});
+}
+
+/*!
+	\brief Horizontal Sobel gradient, [-1 0 1] across and [1 2 1] down
+	\details The output needs a signed Base type and the gradient reaches four times the largest pixel.
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t H>
+void sobelX(const FixedPointImage<T, F>& in, FixedPointImage<U, H>& out, std::size_t threads = 1)
+{
+	static_assert(sizeof(T) <= 2, "Sobel accumulates 16 bit pixels in 32 bits");
+
+	convolve(in, out, SeparableKernel<3, 3, 0, std::int32_t>{ { -1, 0, 1 }, { 1, 2, 1 } }, threads);
+}
+
+/*!
+	\brief Vertical Sobel gradient, [1 2 1] across and [-1 0 1] down
+*/
+template <typename T, std::int8_t F, typename U, std::int8_t H>
+void sobelY(const FixedPointImage<T, F>& in, FixedPointImage<U, H>& out, std::size_t threads = 1)
+{
+	static_assert(sizeof(T) <= 2, "Sobel accumulates 16 bit pixels in 32 bits");
+
+	convolve(in, out, SeparableKernel<3, 3, 0, std::int32_t>{ { 1, 2, 1 }, { -1, 0, 1 } }, threads);
+}
+
+/*!
+	\brief Sampled Gaussian kernel of the given standard deviation
+	\details Coefficients are rounded to G fractional bits and the centre absorbs the rounding, so they sum to
+				exactly one and flat regions pass through unchanged.
+	\tparam Size The number of taps, odd
+	\tparam G The number of fractional bits of the coefficients
+	\tparam A The accumulator
+*/
+template <int Size, std::int8_t G, typename A = std::int64_t>
+SeparableKernel<Size, Size, G, A> gaussianKernel(double sigma)
+{
+	const int RADIUS = Size / 2;
+
+	std::array<double, Size> weights;
+	double total = 0.0;
+	for (int k = 0; k < Size; ++k)
+	{
+		weights[k] = std::exp(-0.5 * (k - RADIUS) * (k - RADIUS) / (sigma * sigma));
+		total += weights[k];
+	}
+
+	SeparableKernel<Size, Size, G, A> kernel;
+	std::int32_t sum = 0;
+	for (int k = 0; k < Size; ++k)
+	{
+		kernel.horizontal[k] = static_cast<std::int32_t>(std::lround(std::ldexp(weights[k] / total, G)));
+		sum += kernel.horizontal[k];
+	}
+
+	kernel.horizontal[RADIUS] += (std::int32_t(1) << G) - sum;
+	kernel.vertical = kernel.horizontal;
+
+	return kernel;
+}
+
+/*!
+	\brief Gaussian blur of 8 and 16 bit pixels
+	\details By default the coefficients take the most fractional bits for which both passes fit 32 bit
+				accumulators and vectorise widely, 7 for unsigned 16 bit pixels and 11 for unsigned 8 bit pixels.
+				Wide kernels or large sigma may need more bits to keep their tail taps from rounding to zero, and
+				asking for more than fit 32 bits accumulates in 64 bits.
+	\tparam Size The number of taps in each direction, odd
+	\tparam G The number of fractional bits of the coefficients, or zero for the most that fit 32 bits
+*/
+template <int Size, std::int8_t G = 0, typename T, std::int8_t F, typename U, std::int8_t H>
+void gaussianBlur(const FixedPointImage<T, F>& in, FixedPointImage<U, H>& out, double sigma, std::size_t threads = 1)
+{
+	static_assert(sizeof(T) <= 2, "Gaussian blur takes 8 or 16 bit pixels");
+
+	const int DIGITS = std::numeric_limits<T>::digits;
+	const std::int8_t BITS = G > 0 ? G : static_cast<std::int8_t>((31 - DIGITS) / 2);
+	static_assert(DIGITS + 2 * BITS <= 63, "Gaussian coefficients must fit a 64 bit accumulator");
+
+	typedef typename std::conditional<DIGITS + 2 * BITS <= 31, std::int32_t, std::int64_t>::type A;
+
+	convolve(in, out, gaussianKernel<Size, BITS, A>(sigma), threads);
+}
@@ -0,0 +1,417 @@
+/*!
+ *  \file FixedPointInstrumentation.h
+ *  \brief Overflow and precision loss instrumentation, enabled by defining FIXEDPOINT_INSTRUMENTATION before
+ *			including FixedPoint.h. When it is not defined none of this is compiled and the hooks within
+ *			FixedPoint.h expand to nothing.
+ */
+
+#pragma once
+
+#ifndef FIXEDPOINT_INSTRUMENTATION
+#error "Define FIXEDPOINT_INSTRUMENTATION before including FixedPoint.h rather than including this file directly"
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <source_location>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+typedef std::source_location FixedPointLocation;
+
+/*!
+	\class FixedPointInstrumentation
+	\brief Records overflows, saturations and truncations of Fixed Point arithmetic keyed by source location
+	\details Every thread counts into its own table so recording never contends with other threads. The tables
+				are merged when a report is requested and the counts of threads that have exited are kept. An
+				event is keyed by the location of the call that caused it, or by the innermost active
+				FIXEDPOINT_SITE() scope as operators can not take the location of their caller.
+*/
+class FixedPointInstrumentation
+{
+public:
+	/*!
+		\brief Merged counts of one source location
+	*/
+	struct SiteReport
+	{
+		std::string file;
+		std::string function;
+		std::uint32_t line = 0;
+		std::uint32_t column = 0;
+
+		/*! Number of results that did not fit within their type and wrapped */
+		std::uint64_t overflows = 0;
+
+		/*! Number of values that were clamped into range */
+		std::uint64_t saturations = 0;
+
+		/*! Number of conversions that discarded non zero fractional bits */
+		std::uint64_t truncations = 0;
+
+		/*! Total number of significant bits discarded by the truncations */
+		std::uint64_t bitsLost = 0;
+	};
+
+	/*!
+		\brief Scope guard attributing every event within the scope to the location it was created at
+	*/
+	class Site
+	{
+	public:
+		explicit Site(const FixedPointLocation& location = FixedPointLocation::current())
+				: _location(location), _previous(current())
+		{
+			current() = &_location;
+		}
+
+		~Site() { current() = _previous; }
+
+		Site(const Site&) = delete;
+		Site& operator=(const Site&) = delete;
+
+	private:
+		FixedPointLocation _location;
+		const FixedPointLocation* _previous;
+	};
+
+	static void recordOverflow(const FixedPointLocation& location) { counters(location).overflows.fetch_add(1, std::memory_order_relaxed); }
+	static void recordSaturation(const FixedPointLocation& location) { counters(location).saturations.fetch_add(1, std::memory_order_relaxed); }
+
+	/*!
+		\brief Record a conversion that discarded bits, nothing is recorded when the discarded bits are all zero
+		\param dropped The discarded bits, as they were before being shifted out
+		\param location The location of the conversion
+	*/
+	static void recordTruncation(std::uint64_t dropped, const FixedPointLocation& location);
+
+	/*!
+		\brief Record an overflow when an exact result is outside of the range of T
+		\param exact The exact result
+		\param location The location of the calculation
+	*/
+	template <typename T>
+	static void checkRange(__int128 exact, const FixedPointLocation& location);
+
+	/*
+		The checks below form the exact result in 128 bits, so they cover every format up to 64 bits.
+	*/
+
+	template <typename T, typename A, typename B>
+	static void checkSum(const A& lhs, const B& rhs, const FixedPointLocation& location);
+
+	template <typename T, typename A, typename B>
+	static void checkDifference(const A& lhs, const B& rhs, const FixedPointLocation& location);
+
+	/*!
+		\brief Record an overflow when (lhs * rhs) >> shift is outside of the range of T
+	*/
+	template <typename T, typename A, typename B>
+	static void checkProduct(const A& lhs, const B& rhs, std::int8_t shift, const FixedPointLocation& location);
+
+	/*!
+		\brief Record the overflow or truncation of shifting initial by shift bits into J, as done by convertType
+		\param initial The value before shifting
+		\param shift The number of bits to shift left by, or right by when negative
+		\param location The location of the conversion
+	*/
+	template <typename J, typename I>
+	static void checkShift(const I& initial, std::int8_t shift, const FixedPointLocation& location);
+
+	/*!
+		\brief Merge the counts of every thread
+		\returns The counts of every location with at least one event, ordered by file and line
+	*/
+	static std::vector<SiteReport> report();
+
+	/*!
+		\brief Write the merged counts as a table
+		\param stream The stream to write to
+	*/
+	static void dump(std::ostream& stream);
+
+	/*!
+		\brief Clear the counts of every thread
+	*/
+	static void reset();
+
+private:
+	struct Counters
+	{
+		std::atomic<std::uint64_t> overflows { 0 };
+		std::atomic<std::uint64_t> saturations { 0 };
+		std::atomic<std::uint64_t> truncations { 0 };
+		std::atomic<std::uint64_t> bitsLost { 0 };
+	};
+
+	/*!
+		\brief Identity of a location within one translation unit, the strings are compared when merging
+	*/
+	struct Key
+	{
+		const char* file;
+		const char* function;
+		std::uint32_t line;
+		std::uint32_t column;
+
+		bool operator==(const Key& rhs) const
+		{
+			return file == rhs.file && function == rhs.function && line == rhs.line && column == rhs.column;
+		}
+	};
+
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& key) const
+		{
+			return std::hash<const void*>()(key.file) ^ (std::size_t(key.line) << 16) ^ key.column;
+		}
+	};
+
+	struct ThreadTable;
+
+	/*!
+		\brief Every live thread table plus the merged counts of exited threads
+	*/
+	struct Registry
+	{
+		std::mutex mutex;
+		std::set<ThreadTable*> tables;
+		std::map<std::tuple<std::string, std::uint32_t, std::uint32_t, std::string>, SiteReport> retired;
+	};
+
+	/*!
+		\brief The counts of one thread. Only the owning thread inserts, under the mutex, so lookups by the owner
+				need no lock. Readers take the mutex and read the counters with relaxed loads.
+	*/
+	struct ThreadTable
+	{
+		std::mutex mutex;
+		std::unordered_map<Key, Counters, KeyHash> sites;
+
+		ThreadTable()
+		{
+			std::lock_guard<std::mutex> lock(registry().mutex);
+			registry().tables.insert(this);
+		}
+
+		~ThreadTable()
+		{
+			std::lock_guard<std::mutex> lock(registry().mutex);
+			merge(*this, registry().retired);
+			registry().tables.erase(this);
+		}
+	};
+
+	static Registry& registry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	static ThreadTable& table()
+	{
+		thread_local ThreadTable table;
+		return table;
+	}
+
+	static const FixedPointLocation*& current()
+	{
+		thread_local const FixedPointLocation* location = nullptr;
+		return location;
+	}
+
+	static Counters& counters(const FixedPointLocation& location);
+
+	static void merge(ThreadTable& table, std::map<std::tuple<std::string, std::uint32_t, std::uint32_t, std::string>, SiteReport>& merged);
+};
+
+inline void FixedPointInstrumentation::recordTruncation(std::uint64_t dropped, const FixedPointLocation& location)
+{
+	if (dropped == 0)
+	{
+		return;
+	}
+
+	std::uint64_t bits = 0;
+	while (dropped != 0)
+	{
+		++bits;
+		dropped >>= 1;
+	}
+
+	Counters& site = counters(location);
+	site.truncations.fetch_add(1, std::memory_order_relaxed);
+	site.bitsLost.fetch_add(bits, std::memory_order_relaxed);
+}
+
+template <typename T>
+void FixedPointInstrumentation::checkRange(__int128 exact, const FixedPointLocation& location)
+{
+	if (exact < static_cast<__int128>(std::numeric_limits<T>::min()) ||
+		exact > static_cast<__int128>(std::numeric_limits<T>::max()))
+	{
+		recordOverflow(location);
+	}
+}
+
+template <typename T, typename A, typename B>
+void FixedPointInstrumentation::checkSum(const A& lhs, const B& rhs, const FixedPointLocation& location)
+{
+	checkRange<T>(static_cast<__int128>(lhs) + static_cast<__int128>(rhs), location);
+}
+
+template <typename T, typename A, typename B>
+void FixedPointInstrumentation::checkDifference(const A& lhs, const B& rhs, const FixedPointLocation& location)
+{
+	checkRange<T>(static_cast<__int128>(lhs) - static_cast<__int128>(rhs), location);
+}
+
+template <typename T, typename A, typename B>
+void FixedPointInstrumentation::checkProduct(const A& lhs, const B& rhs, std::int8_t shift, const FixedPointLocation& location)
+{
+	/* Only the product of two unsigned 64 bit values can exceed a signed 128 bit integer */
+	if constexpr (sizeof(A) == 8 && sizeof(B) == 8 && !std::numeric_limits<A>::is_signed && !std::numeric_limits<B>::is_signed)
+	{
+		unsigned __int128 product = (static_cast<unsigned __int128>(lhs) * static_cast<unsigned __int128>(rhs)) >> shift;
+		if (product > static_cast<unsigned __int128>(std::numeric_limits<T>::max()))
+		{
+			recordOverflow(location);
+		}
+	}
+	else
+	{
+		checkRange<T>((static_cast<__int128>(lhs) * static_cast<__int128>(rhs)) >> shift, location);
+	}
+}
+
+template <typename J, typename I>
+void FixedPointInstrumentation::checkShift(const I& initial, std::int8_t shift, const FixedPointLocation& location)
+{
+	__int128 value = static_cast<__int128>(initial);
+
+	if (shift > 0)
+	{
+		__int128 min = static_cast<__int128>(std::numeric_limits<J>::min());
+		__int128 max = static_cast<__int128>(std::numeric_limits<J>::max());
+
+		if (value < -((-min) >> shift) || value > (max >> shift))
+		{
+			recordOverflow(location);
+		}
+
+		return;
+	}
+
+	std::uint64_t mask = -shift >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << -shift) - 1;
+	recordTruncation(static_cast<std::uint64_t>(value) & mask, location);
+	checkRange<J>(value >> -shift, location);
+}
+
+inline FixedPointInstrumentation::Counters& FixedPointInstrumentation::counters(const FixedPointLocation& location)
+{
+	const FixedPointLocation& site = current() != nullptr ? *current() : location;
+	Key key { site.file_name(), site.function_name(), site.line(), site.column() };
+
+	ThreadTable& local = table();
+	auto found = local.sites.find(key);
+
+	if (found != local.sites.end())
+	{
+		return found->second;
+	}
+
+	std::lock_guard<std::mutex> lock(local.mutex);
+	return local.sites[key];
+}
+
+inline void FixedPointInstrumentation::merge(ThreadTable& table, std::map<std::tuple<std::string, std::uint32_t, std::uint32_t, std::string>, SiteReport>& merged)
+{
+	std::lock_guard<std::mutex> lock(table.mutex);
+
+	for (auto& entry : table.sites)
+	{
+		const Key& key = entry.first;
+		SiteReport& site = merged[std::make_tuple(std::string(key.file), key.line, key.column, std::string(key.function))];
+
+		site.file = key.file;
+		site.function = key.function;
+		site.line = key.line;
+		site.column = key.column;
+		site.overflows += entry.second.overflows.load(std::memory_order_relaxed);
+		site.saturations += entry.second.saturations.load(std::memory_order_relaxed);
+		site.truncations += entry.second.truncations.load(std::memory_order_relaxed);
+		site.bitsLost += entry.second.bitsLost.load(std::memory_order_relaxed);
+	}
+}
+
+inline std::vector<FixedPointInstrumentation::SiteReport> FixedPointInstrumentation::report()
+{
+	std::lock_guard<std::mutex> lock(registry().mutex);
+
+	std::map<std::tuple<std::string, std::uint32_t, std::uint32_t, std::string>, SiteReport> merged = registry().retired;
+	for (ThreadTable* table : registry().tables)
+	{
+		merge(*table, merged);
+	}
+
+	std::vector<SiteReport> sites;
+	for (const auto& entry : merged)
+	{
+		const SiteReport& site = entry.second;
+		if (site.overflows != 0 || site.saturations != 0 || site.truncations != 0)
+		{
+			sites.push_back(site);
+		}
+	}
+
+	return sites;
+}
+
+inline void FixedPointInstrumentation::dump(std::ostream& stream)
+{
+	std::vector<SiteReport> sites = report();
+
+	stream << "Fixed Point instrumentation - " << sites.size() << " sites" << std::endl;
+	for (const SiteReport& site : sites)
+	{
+		stream << site.file << ":" << site.line << ":" << site.column << " " << site.function << std::endl
+			   << "    overflows: " << site.overflows
+			   << "  saturations: " << site.saturations
+			   << "  truncations: " << site.truncations
+			   << "  bits lost: " << site.bitsLost << std::endl;
+	}
+}
+
+inline void FixedPointInstrumentation::reset()
+{
+	std::lock_guard<std::mutex> lock(registry().mutex);
+
+	registry().retired.clear();
+	for (ThreadTable* table : registry().tables)
+	{
+		std::lock_guard<std::mutex> table_lock(table->mutex);
+		for (auto& entry : table->sites)
+		{
+			entry.second.overflows.store(0, std::memory_order_relaxed);
+			entry.second.saturations.store(0, std::memory_order_relaxed);
+			entry.second.truncations.store(0, std::memory_order_relaxed);
+			entry.second.bitsLost.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+#define FIXEDPOINT_SITE_CONCATENATE_INNER(a, b) a##b
+#define FIXEDPOINT_SITE_CONCATENATE(a, b) FIXEDPOINT_SITE_CONCATENATE_INNER(a, b)
+
+/*!
+	\brief Attribute every event within the enclosing scope to this line
+*/
+#define FIXEDPOINT_SITE() FixedPointInstrumentation::Site FIXEDPOINT_SITE_CONCATENATE(fixed_point_site_, __LINE__)
@@ -0,0 +1,378 @@
+/*!
+ *  \file FixedPointIntegrator.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*!
+	\class FixedPointBodies
+	\brief State of many bodies stored as structure of arrays, one contiguous array per component
+	\tparam T The Base type of the components
+	\tparam F The number of fractional bits of the components
+	\tparam D The number of components per body
+*/
+template <typename T, std::int8_t F, std::size_t D>
+class FixedPointBodies
+{
+public:
+	typedef FixedPoint<T, F> value_type;
+
+	static constexpr std::size_t COMPONENTS = D;
+
+	/*!
+		\brief Parameterised constructor. Creates count bodies with every component zero.
+	*/
+	explicit FixedPointBodies(std::size_t count = 0) { resize(count); }
+
+	std::size_t size() const { return _components[0].size(); }
+
+	void resize(std::size_t count)
+	{
+		for (std::vector<value_type>& component : _components)
+		{
+			component.resize(count);
+		}
+	}
+
+	/*!
+		\brief The array of component d of every body
+	*/
+	value_type* component(std::size_t d) { return _components[d].data(); }
+	const value_type* component(std::size_t d) const { return _components[d].data(); }
+
+	value_type& operator()(std::size_t d, std::size_t body) { return _components[d][body]; }
+	const value_type& operator()(std::size_t d, std::size_t body) const { return _components[d][body]; }
+
+private:
+	std::array<std::vector<value_type>, D> _components;
+};
+
+/*!
+	\brief Raw arithmetic shared by the integrators
+	\details Products are formed in twice the width of T and truncated by one shift, so the result of every step
+				depends only on the inputs and never on the compiler, the instruction set or the thread count.
+*/
+template <typename T, std::int8_t F>
+struct IntegratorArithmetic
+{
+	static_assert(std::is_same<T, std::int32_t>::value || std::is_same<T, std::int64_t>::value, "Integrators support int32_t and int64_t Base types");
+
+	typedef typename std::conditional<sizeof(T) <= 4, std::int64_t, __int128>::type Wide;
+
+	/*!
+		\brief raw(a * b) for raw values a and b
+	*/
+	static T multiply(T a, T b) { return static_cast<T>((static_cast<Wide>(a) * b) >> F); }
+};
+
+/*!
+	\brief Run work over contiguous chunks of bodies on the given number of threads
+	\details work(first, last, sync) is called once per thread with its range of bodies, and sync waits for every
+				thread to reach the same point. Chunks only decide which thread computes a body, not how. Nothing
+				is run when there are no bodies.
+*/
+template <typename Work>
+void runBodyChunks(std::size_t threads, std::size_t count, Work work)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	threads = std::max<std::size_t>(1, std::min(threads, count));
+
+	std::barrier<> barrier(static_cast<std::ptrdiff_t>(threads));
+	auto sync = [&barrier, threads]()
+	{
+		if (threads > 1)
+		{
+			barrier.arrive_and_wait();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (std::size_t t = 1; t < threads; ++t)
+	{
+		workers.emplace_back([&work, &sync, t, threads, count]()
+		{
+			work(count * t / threads, count * (t + 1) / threads, sync);
+		});
+	}
+
+	work(0, count / threads, sync);
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+/*!
+	\class RungeKutta4
+	\brief Classical fourth order Runge-Kutta integrator advancing many bodies in fixed point
+	\details The derivative is a functor called as derivative(t, state, first, last, rate) which writes the rates
+				of bodies [first, last) and may read the state of every body. Stages are separated by barriers so
+				coupled systems see consistent states. Integer addition is exact rather than rounded, so as long as
+				the state magnitudes keep every sum over other bodies within T, those sums give the same result in
+				any order and results are bit identical for any number of threads.
+	\tparam T The Base type, int32_t or int64_t
+	\tparam F The number of fractional bits
+	\tparam D The number of state components per body
+*/
+template <typename T, std::int8_t F, std::size_t D>
+class RungeKutta4
+{
+public:
+	typedef FixedPoint<T, F> value_type;
+	typedef FixedPointBodies<T, F, D> Bodies;
+
+	/*!
+		\brief Parameterised constructor.
+		\param threads The number of threads to split the bodies over
+	*/
+	explicit RungeKutta4(std::size_t threads = 1)
+			: _threads(threads)
+	{}
+
+	/*!
+		\brief Advance every body by a number of steps
+		\param derivative The derivative functor
+		\param state The state of the bodies, updated in place
+		\param time The time, advanced by steps * step
+		\param step The time step
+		\param steps The number of steps
+	*/
+	template <typename Derivative>
+	void advance(Derivative&& derivative, Bodies& state, value_type& time, const value_type& step, std::size_t steps);
+
+private:
+	/*!
+		\brief stage = state + scale * rate for bodies [first, last)
+	*/
+	void combine(const Bodies& state, const Bodies& rate, T scale, std::size_t first, std::size_t last);
+
+	/*!
+		\brief state += step * (k1 + 2 k2 + 2 k3 + k4) / 6 for bodies [first, last)
+	*/
+	void update(Bodies& state, T step, std::size_t first, std::size_t last);
+
+	std::size_t _threads;
+	Bodies _k1;
+	Bodies _k2;
+	Bodies _k3;
+	Bodies _k4;
+	Bodies _stage;
+};
+
+template <typename T, std::int8_t F, std::size_t D>
+void RungeKutta4<T, F, D>::combine(const Bodies& state, const Bodies& rate, T scale, std::size_t first, std::size_t last)
+{
+	typedef IntegratorArithmetic<T, F> A;
+
+	for (std::size_t d = 0; d < D; ++d)
+	{
+		const value_type* y = state.component(d);
+		const value_type* k = rate.component(d);
+		value_type* out = _stage.component(d);
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			out[i] = value_type::createFixedPoint(static_cast<T>(y[i].raw() + A::multiply(scale, k[i].raw())));
+		}
+	}
+}
+
+template <typename T, std::int8_t F, std::size_t D>
+void RungeKutta4<T, F, D>::update(Bodies& state, T step, std::size_t first, std::size_t last)
+{
+	typedef typename IntegratorArithmetic<T, F>::Wide Wide;
+
+	for (std::size_t d = 0; d < D; ++d)
+	{
+		value_type* y = state.component(d);
+		const value_type* k1 = _k1.component(d);
+		const value_type* k2 = _k2.component(d);
+		const value_type* k3 = _k3.component(d);
+		const value_type* k4 = _k4.component(d);
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			Wide sum = static_cast<Wide>(k1[i].raw()) + 2 * (static_cast<Wide>(k2[i].raw()) + k3[i].raw()) + k4[i].raw();
+			Wide increment = ((static_cast<Wide>(step) * sum) >> F) / 6;
+			y[i] = value_type::createFixedPoint(static_cast<T>(y[i].raw() + increment));
+		}
+	}
+}
+
+template <typename T, std::int8_t F, std::size_t D>
+template <typename Derivative>
+void RungeKutta4<T, F, D>::advance(Derivative&& derivative, Bodies& state, value_type& time, const value_type& step, std::size_t steps)
+{
+	std::size_t count = state.size();
+	for (Bodies* bodies : { &_k1, &_k2, &_k3, &_k4, &_stage })
+	{
+		bodies->resize(count);
+	}
+
+	const value_type half = value_type::createFixedPoint(static_cast<T>(step.raw() >> 1));
+	const value_type start = time;
+
+	runBodyChunks(_threads, count, [&](std::size_t first, std::size_t last, auto& sync)
+	{
+		value_type t = start;
+
+		for (std::size_t s = 0; s < steps; ++s)
+		{
+			value_type middle = value_type::createFixedPoint(static_cast<T>(t.raw() + half.raw()));
+			value_type end = value_type::createFixedPoint(static_cast<T>(t.raw() + step.raw()));
+
+			derivative(t, static_cast<const Bodies&>(state), first, last, _k1);
+			combine(state, _k1, half.raw(), first, last);
+			sync();
+
+			derivative(middle, static_cast<const Bodies&>(_stage), first, last, _k2);
+			sync();
+			combine(state, _k2, half.raw(), first, last);
+			sync();
+
+			derivative(middle, static_cast<const Bodies&>(_stage), first, last, _k3);
+			sync();
+			combine(state, _k3, step.raw(), first, last);
+			sync();
+
+			derivative(end, static_cast<const Bodies&>(_stage), first, last, _k4);
+			sync();
+			update(state, step.raw(), first, last);
+			sync();
+
+			t = end;
+		}
+	});
+
+	for (std::size_t s = 0; s < steps; ++s)
+	{
+		time = value_type::createFixedPoint(static_cast<T>(time.raw() + step.raw()));
+	}
+}
+
+/*!
+	\class VelocityVerlet
+	\brief Symplectic velocity Verlet integrator advancing many bodies in fixed point
+	\details The acceleration is a functor called as acceleration(positions, first, last, accelerations) which
+				writes the accelerations of bodies [first, last) and may read every position. As with RungeKutta4
+				the results are bit identical for any number of threads.
+	\tparam T The Base type, int32_t or int64_t
+	\tparam F The number of fractional bits
+	\tparam D The number of position components per body
+*/
+template <typename T, std::int8_t F, std::size_t D>
+class VelocityVerlet
+{
+public:
+	typedef FixedPoint<T, F> value_type;
+	typedef FixedPointBodies<T, F, D> Bodies;
+
+	/*!
+		\brief Parameterised constructor.
+		\param threads The number of threads to split the bodies over
+	*/
+	explicit VelocityVerlet(std::size_t threads = 1)
+			: _threads(threads)
+	{}
+
+	/*!
+		\brief Advance every body by a number of steps
+		\param acceleration The acceleration functor
+		\param positions The positions of the bodies, updated in place
+		\param velocities The velocities of the bodies, updated in place
+		\param step The time step
+		\param steps The number of steps
+	*/
+	template <typename Acceleration>
+	void advance(Acceleration&& acceleration, Bodies& positions, Bodies& velocities, const value_type& step, std::size_t steps);
+
+private:
+	/*!
+		\brief velocities += scale * accelerations for bodies [first, last)
+	*/
+	void kick(Bodies& velocities, T scale, std::size_t first, std::size_t last);
+
+	/*!
+		\brief positions += step * velocities for bodies [first, last)
+	*/
+	void drift(Bodies& positions, const Bodies& velocities, T step, std::size_t first, std::size_t last);
+
+	std::size_t _threads;
+	Bodies _accelerations;
+};
+
+template <typename T, std::int8_t F, std::size_t D>
+void VelocityVerlet<T, F, D>::kick(Bodies& velocities, T scale, std::size_t first, std::size_t last)
+{
+	typedef IntegratorArithmetic<T, F> A;
+
+	for (std::size_t d = 0; d < D; ++d)
+	{
+		value_type* v = velocities.component(d);
+		const value_type* a = _accelerations.component(d);
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			v[i] = value_type::createFixedPoint(static_cast<T>(v[i].raw() + A::multiply(scale, a[i].raw())));
+		}
+	}
+}
+
+template <typename T, std::int8_t F, std::size_t D>
+void VelocityVerlet<T, F, D>::drift(Bodies& positions, const Bodies& velocities, T step, std::size_t first, std::size_t last)
+{
+	typedef IntegratorArithmetic<T, F> A;
+
+	for (std::size_t d = 0; d < D; ++d)
+	{
+		value_type* x = positions.component(d);
+		const value_type* v = velocities.component(d);
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			x[i] = value_type::createFixedPoint(static_cast<T>(x[i].raw() + A::multiply(step, v[i].raw())));
+		}
+	}
+}
+
+template <typename T, std::int8_t F, std::size_t D>
+template <typename Acceleration>
+void VelocityVerlet<T, F, D>::advance(Acceleration&& acceleration, Bodies& positions, Bodies& velocities, const value_type& step, std::size_t steps)
+{
+	std::size_t count = positions.size();
+	_accelerations.resize(count);
+
+	const T half = static_cast<T>(step.raw() >> 1);
+
+	runBodyChunks(_threads, count, [&](std::size_t first, std::size_t last, auto& sync)
+	{
+		acceleration(static_cast<const Bodies&>(positions), first, last, _accelerations);
+		sync();
+
+		for (std::size_t s = 0; s < steps; ++s)
+		{
+			kick(velocities, half, first, last);
+			drift(positions, velocities, step.raw(), first, last);
+			sync();
+
+			acceleration(static_cast<const Bodies&>(positions), first, last, _accelerations);
+			sync();
+			kick(velocities, half, first, last);
+		}
+	});
+}
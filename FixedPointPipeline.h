@@ -0,0 +1,448 @@
+/*!
+ *  \file FixedPointPipeline.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*!
+	\class SpscRingBuffer
+	\brief Bounded lock free queue between exactly one producer thread and one consumer thread
+	\tparam V The type of the queued values
+*/
+template <typename V>
+class SpscRingBuffer
+{
+public:
+	/*!
+		\brief Parameterised constructor.
+		\param capacity The minimum number of values the queue can hold, rounded up to a power of two
+	*/
+	explicit SpscRingBuffer(std::size_t capacity);
+
+	/*!
+		\brief Add a value to the queue
+		\returns False when the queue is full
+	*/
+	bool tryPush(const V& value);
+
+	/*!
+		\brief Take the oldest value from the queue
+		\returns False when the queue is empty
+	*/
+	bool tryPop(V& value);
+
+	/*!
+		\brief Add a value, yielding while the queue is full
+	*/
+	void push(const V& value);
+
+	/*!
+		\brief Take the oldest value, yielding while the queue is empty
+	*/
+	V pop();
+
+private:
+	std::vector<V> _values;
+	std::size_t _mask;
+
+	/* Head and tail live on separate cache lines so producer and consumer do not share one */
+	alignas(64) std::atomic<std::size_t> _head = 0;
+	alignas(64) std::atomic<std::size_t> _tail = 0;
+};
+
+template <typename V>
+SpscRingBuffer<V>::SpscRingBuffer(std::size_t capacity)
+{
+	std::size_t size = 1;
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+
+	_values.resize(size);
+	_mask = size - 1;
+}
+
+template <typename V>
+bool SpscRingBuffer<V>::tryPush(const V& value)
+{
+	std::size_t tail = _tail.load(std::memory_order_relaxed);
+	if (tail - _head.load(std::memory_order_acquire) == _values.size())
+	{
+		return false;
+	}
+
+	_values[tail & _mask] = value;
+	_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename V>
+bool SpscRingBuffer<V>::tryPop(V& value)
+{
+	std::size_t head = _head.load(std::memory_order_relaxed);
+	if (head == _tail.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	value = _values[head & _mask];
+	_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename V>
+void SpscRingBuffer<V>::push(const V& value)
+{
+	while (!tryPush(value))
+	{
+		std::this_thread::yield();
+	}
+}
+
+template <typename V>
+V SpscRingBuffer<V>::pop()
+{
+	V value;
+	while (!tryPop(value))
+	{
+		std::this_thread::yield();
+	}
+
+	return value;
+}
+
+/*!
+	\class FixedPointPipeline
+	\brief Streams raw 16 bit ADC samples through quantisation, processing stages and a sink in fixed size chunks
+	\details Each chunk passes through every stage before the next is read, so the working set stays a few chunks
+				in size whatever the length of the stream. Stages work in place on the chunk and hand it on by
+				pointer. When run threaded every stage gets its own thread, connected by single producer single
+				consumer ring buffers, and two chunks per link circulate so each stage can work on one while the
+				next stage consumes the other. The source, stages and sink must not throw.
+	\tparam T The Base type of the processed Fixed Point numbers
+	\tparam F The number of fractional bits of the processed Fixed Point numbers
+*/
+template <typename T, std::int8_t F>
+class FixedPointPipeline
+{
+public:
+	typedef FixedPoint<T, F> value_type;
+
+	/*!
+		\brief Reads up to capacity samples into the buffer and returns the number read, zero at the end of the stream
+	*/
+	typedef std::function<std::size_t(std::int16_t* samples, std::size_t capacity)> Source;
+
+	/*!
+		\brief Processes count values in place and returns the number of values left at the front of the buffer
+	*/
+	typedef std::function<std::size_t(value_type* values, std::size_t count)> Stage;
+
+	/*!
+		\brief Consumes count values
+	*/
+	typedef std::function<void(const value_type* values, std::size_t count)> Sink;
+
+	/*! Default number of samples per chunk, small enough for a chunk and its raw samples to stay in the L2 cache */
+	static const std::size_t DEFAULT_CHUNK = 4096;
+
+	/*!
+		\brief Parameterised constructor.
+		\param chunk The number of samples per chunk
+	*/
+	explicit FixedPointPipeline(std::size_t chunk = DEFAULT_CHUNK)
+			: _chunk(chunk)
+	{}
+
+	/*!
+		\brief Set the source of the pipeline
+		\tparam G The number of fractional bits of the raw samples, which are quantised to F fractional bits
+		\param source The source of raw samples
+	*/
+	template <std::int8_t G>
+	FixedPointPipeline& source(Source source);
+
+	/*!
+		\brief Append a finite impulse response filter, accumulating each output in 64 bits, or 128 bits for a
+				32 bit Base T, and rescaling once
+		\param coefficients The filter taps, the first applying to the newest sample. Throws std::invalid_argument if empty.
+	*/
+	FixedPointPipeline& filter(const std::vector<value_type>& coefficients);
+
+	/*!
+		\brief Append a stage keeping every factor-th value, counted across chunk boundaries
+		\param factor The decimation factor. Throws std::invalid_argument if zero.
+	*/
+	FixedPointPipeline& decimate(std::size_t factor);
+
+	/*!
+		\brief Append a custom stage
+	*/
+	FixedPointPipeline& stage(Stage stage);
+
+	/*!
+		\brief Set the sink of the pipeline
+	*/
+	FixedPointPipeline& sink(Sink sink);
+
+	/*!
+		\brief Process the whole stream
+		\param threaded Whether to run every stage on its own thread
+		\returns The number of values delivered to the sink
+	*/
+	std::size_t run(bool threaded = false);
+
+private:
+	struct Chunk
+	{
+		std::vector<std::int16_t> samples;
+		std::vector<value_type> values;
+		std::size_t count = 0;
+		bool last = false;
+	};
+
+	typedef std::function<void(const std::int16_t* samples, value_type* values, std::size_t count)> Quantiser;
+
+	/*!
+		\brief Read the next chunk from the source and quantise it
+	*/
+	void read(Chunk& chunk);
+
+	std::size_t runSequential();
+	std::size_t runThreaded();
+
+	std::size_t _chunk;
+	Source _source;
+	Quantiser _quantiser;
+	std::vector<Stage> _stages;
+	Sink _sink;
+};
+
+template <typename T, std::int8_t F>
+template <std::int8_t G>
+FixedPointPipeline<T, F>& FixedPointPipeline<T, F>::source(Source source)
+{
+	_source = source;
+	_quantiser = [](const std::int16_t* samples, value_type* values, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			values[i] = FixedPoint<std::int16_t, G>::createFixedPoint(samples[i]).template convert<T, F>();
+		}
+	};
+
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+FixedPointPipeline<T, F>& FixedPointPipeline<T, F>::filter(const std::vector<value_type>& coefficients)
+{
+	static_assert(sizeof(T) <= 4, "Filter accumulation needs a Base T of at most 32 bits");
+	typedef typename std::conditional<sizeof(T) <= 2, std::int64_t, __int128>::type A;
+
+	if (coefficients.empty())
+	{
+		throw std::invalid_argument("A filter needs at least one coefficient");
+	}
+
+	/* The window holds the last taps - 1 inputs of the previous chunk followed by the current chunk */
+	std::size_t taps = coefficients.size();
+	std::shared_ptr<std::vector<std::int64_t>> window = std::make_shared<std::vector<std::int64_t>>(taps - 1 + _chunk, 0);
+
+	return stage([coefficients, taps, window](value_type* values, std::size_t count)
+	{
+		std::int64_t* history = window->data();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			history[taps - 1 + i] = values[i].raw();
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			A sum = 0;
+			for (std::size_t k = 0; k < taps; ++k)
+			{
+				sum += static_cast<A>(coefficients[k].raw()) * history[taps - 1 + i - k];
+			}
+
+			values[i] = value_type::createFixedPoint(static_cast<T>(sum >> F));
+		}
+
+		for (std::size_t k = 0; k + 1 < taps; ++k)
+		{
+			history[k] = history[count + k];
+		}
+
+		return count;
+	});
+}
+
+template <typename T, std::int8_t F>
+FixedPointPipeline<T, F>& FixedPointPipeline<T, F>::decimate(std::size_t factor)
+{
+	if (factor == 0)
+	{
+		throw std::invalid_argument("The decimation factor must be at least one");
+	}
+
+	std::shared_ptr<std::size_t> phase = std::make_shared<std::size_t>(0);
+
+	return stage([factor, phase](value_type* values, std::size_t count)
+	{
+		std::size_t kept = 0;
+		std::size_t i = (factor - *phase) % factor;
+
+		for (; i < count; i += factor)
+		{
+			values[kept++] = values[i];
+		}
+
+		*phase = (*phase + count) % factor;
+		return kept;
+	});
+}
+
+template <typename T, std::int8_t F>
+FixedPointPipeline<T, F>& FixedPointPipeline<T, F>::stage(Stage stage)
+{
+	_stages.push_back(stage);
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+FixedPointPipeline<T, F>& FixedPointPipeline<T, F>::sink(Sink sink)
+{
+	_sink = sink;
+	return *this;
+}
+
+template <typename T, std::int8_t F>
+void FixedPointPipeline<T, F>::read(Chunk& chunk)
+{
+	chunk.count = _source(chunk.samples.data(), _chunk);
+	chunk.last = chunk.count == 0;
+	_quantiser(chunk.samples.data(), chunk.values.data(), chunk.count);
+}
+
+template <typename T, std::int8_t F>
+std::size_t FixedPointPipeline<T, F>::run(bool threaded)
+{
+	return threaded ? runThreaded() : runSequential();
+}
+
+template <typename T, std::int8_t F>
+std::size_t FixedPointPipeline<T, F>::runSequential()
+{
+	Chunk chunk;
+	chunk.samples.resize(_chunk);
+	chunk.values.resize(_chunk);
+
+	std::size_t delivered = 0;
+
+	for (read(chunk); !chunk.last; read(chunk))
+	{
+		for (const Stage& stage : _stages)
+		{
+			chunk.count = stage(chunk.values.data(), chunk.count);
+		}
+
+		_sink(chunk.values.data(), chunk.count);
+		delivered += chunk.count;
+	}
+
+	return delivered;
+}
+
+template <typename T, std::int8_t F>
+std::size_t FixedPointPipeline<T, F>::runThreaded()
+{
+	/* Links run from the source to each stage and on to the sink, with one more returning spent chunks */
+	std::size_t links = _stages.size() + 1;
+	std::size_t pool = 2 * links;
+
+	std::vector<Chunk> chunks(pool);
+	std::vector<std::unique_ptr<SpscRingBuffer<Chunk*>>> queues;
+	for (std::size_t i = 0; i <= links; ++i)
+	{
+		queues.push_back(std::make_unique<SpscRingBuffer<Chunk*>>(pool));
+	}
+
+	SpscRingBuffer<Chunk*>& free_chunks = *queues[links];
+	for (Chunk& chunk : chunks)
+	{
+		chunk.samples.resize(_chunk);
+		chunk.values.resize(_chunk);
+		free_chunks.push(&chunk);
+	}
+
+	std::vector<std::thread> threads;
+
+	threads.emplace_back([this, &queues, &free_chunks]()
+	{
+		/* A chunk belongs to the next stage once pushed, so its flag is read before handing it on */
+		bool last;
+		do
+		{
+			Chunk* chunk = free_chunks.pop();
+			read(*chunk);
+			last = chunk->last;
+			queues[0]->push(chunk);
+		}
+		while (!last);
+	});
+
+	for (std::size_t s = 0; s < _stages.size(); ++s)
+	{
+		threads.emplace_back([this, s, &queues]()
+		{
+			bool last;
+			do
+			{
+				Chunk* chunk = queues[s]->pop();
+				last = chunk->last;
+				if (!last)
+				{
+					chunk->count = _stages[s](chunk->values.data(), chunk->count);
+				}
+				queues[s + 1]->push(chunk);
+			}
+			while (!last);
+		});
+	}
+
+	/* The sink runs on the calling thread */
+	std::size_t delivered = 0;
+	bool last;
+	do
+	{
+		Chunk* chunk = queues[links - 1]->pop();
+		last = chunk->last;
+		if (!last)
+		{
+			_sink(chunk->values.data(), chunk->count);
+			delivered += chunk->count;
+		}
+		free_chunks.push(chunk);
+	}
+	while (!last);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	return delivered;
+}
@@ -0,0 +1,523 @@
+/*!
+ *  \file FixedPointRandom.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+/*!
+	\brief The Philox4x32-10 counter based generator of Salmon, Moraes, Dror and Shaw
+	\details Each 128 bit counter is mapped to 128 random bits by ten rounds of 32 bit multiplies keyed by a 64 bit
+				key. Any block can be computed directly from its counter, so streams can be split, skipped and
+				generated in parallel with identical results.
+*/
+struct Philox4x32
+{
+	typedef std::array<std::uint32_t, 4> Counter;
+	typedef std::array<std::uint32_t, 2> Key;
+
+	static constexpr int ROUNDS = 10;
+
+	/*! Blocks generated together by the batch form */
+	static constexpr std::size_t BATCH = 16;
+
+	static constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53u;
+	static constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57u;
+	static constexpr std::uint32_t WEYL_0 = 0x9E3779B9u;
+	static constexpr std::uint32_t WEYL_1 = 0xBB67AE85u;
+
+	/*!
+		\brief The random block of one counter
+	*/
+	static Counter generate(Counter counter, Key key);
+
+	/*!
+		\brief The random blocks of consecutive counters {index, stream}, with index and stream split in 32 bit halves
+		\details Rounds are applied to BATCH counters at a time held in separate arrays, so every round is a
+					plain loop the compiler can vectorise.
+		\param index The index of the first block
+		\param stream The upper half of every counter
+		\param key The key
+		\param out The words of the blocks, four per block
+		\param blocks The number of blocks
+	*/
+	static void generate(std::uint64_t index, std::uint64_t stream, Key key, std::uint32_t* out, std::size_t blocks);
+};
+
+inline Philox4x32::Counter Philox4x32::generate(Counter counter, Key key)
+{
+	for (int round = 0; round < ROUNDS; ++round)
+	{
+		std::uint64_t product0 = static_cast<std::uint64_t>(MULTIPLIER_0) * counter[0];
+		std::uint64_t product1 = static_cast<std::uint64_t>(MULTIPLIER_1) * counter[2];
+
+		counter = { static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(product1),
+			static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(product0) };
+
+		key[0] += WEYL_0;
+		key[1] += WEYL_1;
+	}
+
+	return counter;
+}
+
+inline void Philox4x32::generate(std::uint64_t index, std::uint64_t stream, Key key, std::uint32_t* out, std::size_t blocks)
+{
+	for (std::size_t done = 0; done < blocks; done += BATCH)
+	{
+		std::size_t n = std::min(BATCH, blocks - done);
+
+		std::uint32_t c0[BATCH];
+		std::uint32_t c1[BATCH];
+		std::uint32_t c2[BATCH];
+		std::uint32_t c3[BATCH];
+
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			std::uint64_t block = index + done + j;
+			c0[j] = static_cast<std::uint32_t>(block);
+			c1[j] = static_cast<std::uint32_t>(block >> 32);
+			c2[j] = static_cast<std::uint32_t>(stream);
+			c3[j] = static_cast<std::uint32_t>(stream >> 32);
+		}
+
+		std::uint32_t k0 = key[0];
+		std::uint32_t k1 = key[1];
+
+		for (int round = 0; round < ROUNDS; ++round)
+		{
+			for (std::size_t j = 0; j < n; ++j)
+			{
+				std::uint64_t product0 = static_cast<std::uint64_t>(MULTIPLIER_0) * c0[j];
+				std::uint64_t product1 = static_cast<std::uint64_t>(MULTIPLIER_1) * c2[j];
+
+				c0[j] = static_cast<std::uint32_t>(product1 >> 32) ^ c1[j] ^ k0;
+				c1[j] = static_cast<std::uint32_t>(product1);
+				c2[j] = static_cast<std::uint32_t>(product0 >> 32) ^ c3[j] ^ k1;
+				c3[j] = static_cast<std::uint32_t>(product0);
+			}
+
+			k0 += WEYL_0;
+			k1 += WEYL_1;
+		}
+
+		for (std::size_t j = 0; j < n; ++j)
+		{
+			std::uint32_t* block = out + 4 * (done + j);
+			block[0] = c0[j];
+			block[1] = c1[j];
+			block[2] = c2[j];
+			block[3] = c3[j];
+		}
+	}
+}
+
+/*!
+	\class FixedPointRandom
+	\brief Reproducible stream of random Fixed Point numbers built on Philox4x32-10
+	\details The 64 bit seed is the key and the 64 bit stream number is the upper half of every counter, so the
+				streams of one seed never overlap. Giving each thread its own stream makes parallel runs
+				deterministic without coordination. Every value is produced from raw bits with integer arithmetic
+				only, so results depend on the seed, stream and position alone and never on the platform or
+				standard library. Bulk fills consume exactly the words the same number of single draws would.
+*/
+class FixedPointRandom
+{
+public:
+	/*! Fractional bits of the internal Gaussian values */
+	static constexpr int GAUSSIAN_FRACTION = 40;
+
+	/*!
+		\brief Parameterised constructor.
+		\param seed The seed, shared by every stream of a run
+		\param stream The stream number, for example the index of a thread
+	*/
+	explicit FixedPointRandom(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+	std::uint64_t seed() const { return (static_cast<std::uint64_t>(_key[1]) << 32) | _key[0]; }
+	std::uint64_t stream() const { return _stream; }
+
+	/*!
+		\brief The number of 32 bit words drawn so far
+	*/
+	std::uint64_t position() const { return 4 * _block + _used - 4; }
+
+	/*!
+		\brief Move to any position of the stream in constant time, discarding a cached Gaussian value
+	*/
+	void seek(std::uint64_t position);
+
+	std::uint32_t next32();
+
+	/*!
+		\brief Two words, the first as the low half
+	*/
+	std::uint64_t next64();
+
+	/*!
+		\brief Fill an array with the next count words
+	*/
+	void fillWords(std::uint32_t* words, std::size_t count);
+
+	/*!
+		\brief A number with every raw value equally likely
+	*/
+	template <typename T, std::int8_t F>
+	FixedPoint<T, F> bits();
+
+	/*!
+		\brief A number uniform on [0, 1), the top F bits of a draw
+	*/
+	template <typename T, std::int8_t F>
+	FixedPoint<T, F> uniform();
+
+	/*!
+		\brief A number uniform on [low, high) by multiplying the width of the range by a draw
+		\details No draws are rejected, so the probabilities of the raw values differ by at most one part in
+					2^32 / (high - low) for Base types of up to 32 bits and 2^64 / (high - low) beyond.
+	*/
+	template <typename T, std::int8_t F>
+	FixedPoint<T, F> uniform(const FixedPoint<T, F>& low, const FixedPoint<T, F>& high);
+
+	/*!
+		\brief A number from the standard normal distribution
+		\details Generated in pairs by the polar form of the Box-Muller transform in fixed point, with about 30
+					significant bits. Pairs beyond about 7.4 standard deviations are rejected, and values outside
+					the range of the format saturate.
+	*/
+	template <typename T, std::int8_t F>
+	FixedPoint<T, F> gaussian();
+
+	template <typename T, std::int8_t F>
+	void fillUniform(FixedPoint<T, F>* out, std::size_t count);
+
+	template <typename T, std::int8_t F>
+	void fillUniform(FixedPoint<T, F>* out, std::size_t count, const FixedPoint<T, F>& low, const FixedPoint<T, F>& high);
+
+	template <typename T, std::int8_t F>
+	void fillGaussian(FixedPoint<T, F>* out, std::size_t count);
+
+private:
+	/*! Words drawn per uniform number on [0, 1) */
+	template <std::int8_t F>
+	static constexpr int UNIFORM_WORDS = F <= 32 ? 1 : 2;
+
+	/*! Words drawn per number with every raw value or on a range */
+	template <typename T>
+	static constexpr int RANGE_WORDS = sizeof(T) <= 4 ? 1 : 2;
+
+	template <int Words>
+	static std::uint64_t combine(const std::uint32_t* words)
+	{
+		return Words == 1 ? words[0] : (static_cast<std::uint64_t>(words[1]) << 32) | words[0];
+	}
+
+	template <typename T, std::int8_t F>
+	static FixedPoint<T, F> uniformFromWords(const std::uint32_t* words);
+
+	template <typename T, std::int8_t F>
+	static FixedPoint<T, F> rangeFromWords(const std::uint32_t* words, const FixedPoint<T, F>& low, const FixedPoint<T, F>& high);
+
+	/*!
+		\brief The fractional part of log2(m) to 32 bits for m in [1, 2) with 62 fractional bits, by repeated squaring
+	*/
+	static std::uint64_t log2Fraction(std::uint64_t m);
+
+	/*!
+		\brief floor(sqrt(n))
+	*/
+	static std::uint64_t squareRoot(unsigned __int128 n);
+
+	/*!
+		\brief The next pair of normal values with GAUSSIAN_FRACTION fractional bits
+	*/
+	void gaussianPair(std::int64_t& first, std::int64_t& second);
+
+	Philox4x32::Key _key;
+	std::uint64_t _stream;
+
+	/*! Index of the next block to generate */
+	std::uint64_t _block;
+
+	Philox4x32::Counter _buffer;
+
+	/*! Words of the buffer already drawn, 4 when it is empty */
+	unsigned _used;
+
+	bool _hasGaussian;
+	std::int64_t _gaussian;
+};
+
+inline FixedPointRandom::FixedPointRandom(std::uint64_t seed, std::uint64_t stream)
+		: _key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) }, _stream(stream), _block(0), _buffer{},
+		  _used(4), _hasGaussian(false), _gaussian(0)
+{}
+
+inline void FixedPointRandom::seek(std::uint64_t position)
+{
+	_block = position / 4;
+	_used = 4;
+	_hasGaussian = false;
+
+	if (position % 4 != 0)
+	{
+		next32();
+		_used = static_cast<unsigned>(position % 4);
+	}
+}
+
+inline std::uint32_t FixedPointRandom::next32()
+{
+	if (_used == 4)
+	{
+		_buffer = Philox4x32::generate({ static_cast<std::uint32_t>(_block), static_cast<std::uint32_t>(_block >> 32),
+			static_cast<std::uint32_t>(_stream), static_cast<std::uint32_t>(_stream >> 32) }, _key);
+		++_block;
+		_used = 0;
+	}
+
+	return _buffer[_used++];
+}
+
+inline std::uint64_t FixedPointRandom::next64()
+{
+	std::uint64_t low = next32();
+	return (static_cast<std::uint64_t>(next32()) << 32) | low;
+}
+
+inline void FixedPointRandom::fillWords(std::uint32_t* words, std::size_t count)
+{
+	std::size_t i = 0;
+	while (i < count && _used < 4)
+	{
+		words[i++] = _buffer[_used++];
+	}
+
+	std::size_t blocks = (count - i) / 4;
+	Philox4x32::generate(_block, _stream, _key, words + i, blocks);
+	_block += blocks;
+	i += 4 * blocks;
+
+	while (i < count)
+	{
+		words[i++] = next32();
+	}
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> FixedPointRandom::uniformFromWords(const std::uint32_t* words)
+{
+	static_assert(F <= std::numeric_limits<T>::digits, "[0, 1) must be representable");
+
+	const int WORDS = UNIFORM_WORDS<F>;
+	return FixedPoint<T, F>::createFixedPoint(static_cast<T>(combine<WORDS>(words) >> (32 * WORDS - F)));
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> FixedPointRandom::rangeFromWords(const std::uint32_t* words, const FixedPoint<T, F>& low, const FixedPoint<T, F>& high)
+{
+	typedef typename std::make_unsigned<T>::type U;
+
+	const int WORDS = RANGE_WORDS<T>;
+	std::uint64_t width = static_cast<U>(static_cast<U>(high.raw()) - static_cast<U>(low.raw()));
+	std::uint64_t offset = static_cast<std::uint64_t>((static_cast<unsigned __int128>(width) * combine<WORDS>(words)) >> (32 * WORDS));
+
+	return FixedPoint<T, F>::createFixedPoint(static_cast<T>(static_cast<U>(static_cast<U>(low.raw()) + static_cast<U>(offset))));
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> FixedPointRandom::bits()
+{
+	return FixedPoint<T, F>::createFixedPoint(static_cast<T>(RANGE_WORDS<T> == 1 ? next32() : next64()));
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> FixedPointRandom::uniform()
+{
+	std::uint32_t words[2];
+	fillWords(words, UNIFORM_WORDS<F>);
+
+	return uniformFromWords<T, F>(words);
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> FixedPointRandom::uniform(const FixedPoint<T, F>& low, const FixedPoint<T, F>& high)
+{
+	std::uint32_t words[2];
+	fillWords(words, RANGE_WORDS<T>);
+
+	return rangeFromWords(words, low, high);
+}
+
+template <typename T, std::int8_t F>
+void FixedPointRandom::fillUniform(FixedPoint<T, F>* out, std::size_t count)
+{
+	const int WORDS = UNIFORM_WORDS<F>;
+	std::uint32_t words[256];
+
+	for (std::size_t done = 0; done < count;)
+	{
+		std::size_t n = std::min(count - done, std::size_t(256 / WORDS));
+		fillWords(words, n * WORDS);
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			out[done + i] = uniformFromWords<T, F>(words + WORDS * i);
+		}
+
+		done += n;
+	}
+}
+
+template <typename T, std::int8_t F>
+void FixedPointRandom::fillUniform(FixedPoint<T, F>* out, std::size_t count, const FixedPoint<T, F>& low, const FixedPoint<T, F>& high)
+{
+	const int WORDS = RANGE_WORDS<T>;
+	std::uint32_t words[256];
+
+	for (std::size_t done = 0; done < count;)
+	{
+		std::size_t n = std::min(count - done, std::size_t(256 / WORDS));
+		fillWords(words, n * WORDS);
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			out[done + i] = rangeFromWords(words + WORDS * i, low, high);
+		}
+
+		done += n;
+	}
+}
+
+inline std::uint64_t FixedPointRandom::log2Fraction(std::uint64_t m)
+{
+	const std::uint64_t TWO = std::uint64_t(1) << 63;
+
+	std::uint64_t fraction = 0;
+	for (int bit = 31; bit >= 0; --bit)
+	{
+		m = static_cast<std::uint64_t>((static_cast<unsigned __int128>(m) * m) >> 62);
+		if (m >= TWO)
+		{
+			m >>= 1;
+			fraction |= std::uint64_t(1) << bit;
+		}
+	}
+
+	return fraction;
+}
+
+inline std::uint64_t FixedPointRandom::squareRoot(unsigned __int128 n)
+{
+	unsigned __int128 root = 0;
+	unsigned __int128 bit = static_cast<unsigned __int128>(1) << 126;
+
+	while (bit > n)
+	{
+		bit >>= 2;
+	}
+
+	while (bit != 0)
+	{
+		if (n >= root + bit)
+		{
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	return static_cast<std::uint64_t>(root);
+}
+
+inline void FixedPointRandom::gaussianPair(std::int64_t& first, std::int64_t& second)
+{
+	/* ln(2) with 64 fractional bits */
+	const std::uint64_t LN2 = 0xB17217F7D1CF79ABull;
+
+	for (;;)
+	{
+		/* u and v uniform on [-1, 1) with 31 fractional bits, s = u^2 + v^2 with 62 */
+		std::int64_t u = static_cast<std::int32_t>(next32());
+		std::int64_t v = static_cast<std::int32_t>(next32());
+		std::uint64_t s = static_cast<std::uint64_t>(u * u) + static_cast<std::uint64_t>(v * v);
+
+		if (s >= (std::uint64_t(1) << 62) || s < (std::uint64_t(1) << 22))
+		{
+			continue;
+		}
+
+		/* s = n * 4^-e with n in [1/4, 1), and n = m * 2^-k with m in [1, 2) */
+		int e = (std::countl_zero(s) - 2) / 2;
+		std::uint64_t n = s << (2 * e);
+		int k = std::countl_zero(n) - 1;
+		std::uint64_t m = n << k;
+
+		/* -ln(s) with 32 fractional bits */
+		std::uint64_t log2 = (static_cast<std::uint64_t>(k + 2 * e) << 32) - log2Fraction(m);
+		std::uint64_t log = static_cast<std::uint64_t>((static_cast<unsigned __int128>(log2) * LN2) >> 64);
+
+		/* sqrt(-2 ln(s) / s) = 2^e sqrt(-2 ln(s) / n), with 32 fractional bits before the 2^e */
+		std::uint64_t ratio = static_cast<std::uint64_t>((static_cast<unsigned __int128>(2 * log) << 62) / n);
+		std::uint64_t factor = squareRoot(static_cast<unsigned __int128>(ratio) << 32);
+
+		const int SHIFT = 31 + 32 - GAUSSIAN_FRACTION - e;
+		first = static_cast<std::int64_t>((static_cast<__int128>(u) * factor) >> SHIFT);
+		second = static_cast<std::int64_t>((static_cast<__int128>(v) * factor) >> SHIFT);
+		return;
+	}
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> FixedPointRandom::gaussian()
+{
+	static_assert(std::numeric_limits<T>::is_signed, "Normal values need a signed Base type");
+	static_assert(F <= 62, "Unsupported number of fractional bits");
+
+	std::int64_t value;
+	if (_hasGaussian)
+	{
+		value = _gaussian;
+		_hasGaussian = false;
+	}
+	else
+	{
+		gaussianPair(value, _gaussian);
+		_hasGaussian = true;
+	}
+
+	__int128 raw;
+	if constexpr (F <= GAUSSIAN_FRACTION)
+	{
+		raw = static_cast<__int128>(value) >> (GAUSSIAN_FRACTION - F);
+	}
+	else
+	{
+		raw = static_cast<__int128>(value) * (static_cast<__int128>(1) << (F - GAUSSIAN_FRACTION));
+	}
+
+	raw = std::clamp<__int128>(raw, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+
+	return FixedPoint<T, F>::createFixedPoint(static_cast<T>(raw));
+}
+
+template <typename T, std::int8_t F>
+void FixedPointRandom::fillGaussian(FixedPoint<T, F>* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = gaussian<T, F>();
+	}
+}
@@ -0,0 +1,228 @@
+/*!
+ *  \file FixedPointSort.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/*!
+	\brief Order preserving unsigned keys of Fixed Point numbers
+	\details Flipping the sign bit of a two's complement raw value maps the lowest value to zero and the highest
+				to all ones, so unsigned order of the keys is the numeric order of the values and sorting and
+				selection work on plain integer digits.
+*/
+template <typename T, std::int8_t F>
+struct RadixKey
+{
+	typedef typename std::make_unsigned<T>::type Type;
+
+	static const int BITS = static_cast<int>(sizeof(T) * 8);
+
+	/*! Number of 8 bit digits */
+	static const int DIGITS = static_cast<int>(sizeof(T));
+
+	static Type key(const FixedPoint<T, F>& value)
+	{
+		Type sign = std::numeric_limits<T>::is_signed ? static_cast<Type>(Type(1) << (BITS - 1)) : Type(0);
+		return static_cast<Type>(static_cast<Type>(value.raw()) ^ sign);
+	}
+
+	static std::size_t digit(Type key, int d) { return static_cast<std::size_t>((key >> (8 * d)) & 0xFF); }
+};
+
+/*!
+	\brief Sort an array of Fixed Point numbers with a least significant digit radix sort
+	\details Every digit is counted in one pass over the data, after which each digit needing to be sorted costs
+				one stable scatter. Digits that are the same for every element are skipped, so data confined to a
+				narrow range sorts in fewer passes. Runs in linear time with a scratch copy of the array.
+	\param data The numbers to sort in place
+	\param count The number of elements
+*/
+template <typename T, std::int8_t F>
+void radixSort(FixedPoint<T, F>* data, std::size_t count)
+{
+	typedef RadixKey<T, F> Key;
+
+	std::array<std::array<std::size_t, 256>, Key::DIGITS> counts = {};
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		typename Key::Type key = Key::key(data[i]);
+		for (int d = 0; d < Key::DIGITS; ++d)
+		{
+			++counts[d][Key::digit(key, d)];
+		}
+	}
+
+	std::vector<FixedPoint<T, F>> scratch(count);
+	FixedPoint<T, F>* from = data;
+	FixedPoint<T, F>* to = scratch.data();
+
+	for (int d = 0; d < Key::DIGITS; ++d)
+	{
+		if (count == 0 || counts[d][Key::digit(Key::key(from[0]), d)] == count)
+		{
+			continue;
+		}
+
+		std::array<std::size_t, 256> offsets;
+		std::size_t offset = 0;
+		for (std::size_t b = 0; b < 256; ++b)
+		{
+			offsets[b] = offset;
+			offset += counts[d][b];
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			to[offsets[Key::digit(Key::key(from[i]), d)]++] = from[i];
+		}
+
+		std::swap(from, to);
+	}
+
+	if (from != data)
+	{
+		std::copy(from, from + count, data);
+	}
+}
+
+/*!
+	\brief Count the numbers falling in each of 2^Bits equal bins spanning the whole range of the format
+	\details The bin is the top Bits bits of the order preserving key, so binning is a shift. Four interleaved sets
+				of counts are kept and summed at the end, so runs of equal bins do not stall on incrementing the
+				same counter.
+	\tparam Bits The number of bits of the bin index, at most 16
+	\param data The numbers
+	\param count The number of elements
+	\param bins The 2^Bits counts, which are added to
+*/
+template <int Bits, typename T, std::int8_t F>
+void histogram(const FixedPoint<T, F>* data, std::size_t count, std::uint64_t* bins)
+{
+	typedef RadixKey<T, F> Key;
+	static_assert(Bits >= 1 && Bits <= 16 && Bits <= Key::BITS, "Bits must be between 1 and 16 and no more than the width of the format");
+
+	const std::size_t SIZE = std::size_t(1) << Bits;
+	const int SHIFT = Key::BITS - Bits;
+
+	std::vector<std::uint32_t> partial(4 * SIZE, 0);
+	std::uint32_t* lanes[4] = { partial.data(), partial.data() + SIZE, partial.data() + 2 * SIZE, partial.data() + 3 * SIZE };
+
+	/* 32 bit counters are flushed before they can overflow */
+	const std::size_t FLUSH = std::size_t(1) << 30;
+
+	for (std::size_t first = 0; first < count; first += FLUSH)
+	{
+		std::size_t last = std::min(count, first + FLUSH);
+		std::size_t i = first;
+
+		for (; i + 4 <= last; i += 4)
+		{
+			++lanes[0][Key::key(data[i]) >> SHIFT];
+			++lanes[1][Key::key(data[i + 1]) >> SHIFT];
+			++lanes[2][Key::key(data[i + 2]) >> SHIFT];
+			++lanes[3][Key::key(data[i + 3]) >> SHIFT];
+		}
+
+		for (; i < last; ++i)
+		{
+			++lanes[0][Key::key(data[i]) >> SHIFT];
+		}
+
+		for (std::size_t b = 0; b < SIZE; ++b)
+		{
+			bins[b] += std::uint64_t(lanes[0][b]) + lanes[1][b] + lanes[2][b] + lanes[3][b];
+		}
+
+		std::fill(partial.begin(), partial.end(), 0);
+	}
+}
+
+/*!
+	\brief Find the number that would be at position n if the array were sorted, without reordering it
+	\details A most significant digit radix select: each pass counts one digit of the remaining candidates and
+				keeps only those in the bucket holding position n, so the work is linear in count.
+	\param data The numbers
+	\param count The number of elements, at least one
+	\param n The position, from zero for the lowest. Positions past the end give the largest number.
+*/
+template <typename T, std::int8_t F>
+FixedPoint<T, F> nthElement(const FixedPoint<T, F>* data, std::size_t count, std::size_t n)
+{
+	typedef RadixKey<T, F> Key;
+
+	n = std::min(n, count - 1);
+
+	std::vector<FixedPoint<T, F>> candidates;
+	const FixedPoint<T, F>* current = data;
+	std::size_t remaining = count;
+
+	for (int d = Key::DIGITS - 1; d >= 0; --d)
+	{
+		std::array<std::size_t, 256> counts = {};
+		for (std::size_t i = 0; i < remaining; ++i)
+		{
+			++counts[Key::digit(Key::key(current[i]), d)];
+		}
+
+		std::size_t bucket = 0;
+		while (n >= counts[bucket])
+		{
+			n -= counts[bucket];
+			++bucket;
+		}
+
+		if (counts[bucket] == remaining)
+		{
+			continue;
+		}
+
+		std::vector<FixedPoint<T, F>> next;
+		next.reserve(counts[bucket]);
+		for (std::size_t i = 0; i < remaining; ++i)
+		{
+			if (Key::digit(Key::key(current[i]), d) == bucket)
+			{
+				next.push_back(current[i]);
+			}
+		}
+
+		candidates.swap(next);
+		current = candidates.data();
+		remaining = candidates.size();
+	}
+
+	return current[0];
+}
+
+/*!
+	\brief The lower median, the number at position (count - 1) / 2 of the sorted array
+*/
+template <typename T, std::int8_t F>
+FixedPoint<T, F> median(const FixedPoint<T, F>* data, std::size_t count)
+{
+	return nthElement(data, count, (count - 1) / 2);
+}
+
+/*!
+	\brief Percentile by the nearest rank method, the smallest number at least percent of the array is not above
+	\param data The numbers
+	\param count The number of elements, at least one
+	\param percent The percentile, from 0 to 100
+*/
+template <typename T, std::int8_t F>
+FixedPoint<T, F> percentile(const FixedPoint<T, F>* data, std::size_t count, double percent)
+{
+	double rank = std::ceil(percent / 100.0 * static_cast<double>(count));
+	std::size_t n = rank < 1.0 ? 0 : std::min(count, static_cast<std::size_t>(rank)) - 1;
+
+	return nthElement(data, count, n);
+}
@@ -0,0 +1,353 @@
+/*!
+ *  \file LookupTable.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+/*!
+	\brief Raw value saturated to the range of V
+*/
+template <typename V>
+constexpr V saturateRaw(std::int64_t value)
+{
+	if (value > static_cast<std::int64_t>(std::numeric_limits<V>::max()))
+	{
+		return std::numeric_limits<V>::max();
+	}
+
+	if (value < static_cast<std::int64_t>(std::numeric_limits<V>::min()))
+	{
+		return std::numeric_limits<V>::min();
+	}
+
+	return static_cast<V>(value);
+}
+
+/*!
+	\brief Breakpoint layout shared by the one and two dimensional lookup tables
+	\details The whole range of the input format is split into 2^Bits equal intervals. The interval of an input is
+				its raw value with the sign bit flipped, shifted right by SHIFT, and the bits shifted out are the
+				position within the interval, so finding the interval needs no search and no division.
+	\tparam T The Base type of the input
+	\tparam F The number of fractional bits of the input
+	\tparam Bits The number of index bits, giving 2^Bits + 1 breakpoints
+*/
+template <typename T, std::int8_t F, int Bits>
+struct LookupTableAxis
+{
+	static const int WIDTH = static_cast<int>(sizeof(T) * 8);
+	static_assert(sizeof(T) <= 4, "The input of a lookup table must have a Base T of at most 32 bits");
+	static_assert(Bits >= 1 && Bits < WIDTH, "Bits must be at least one and less than the width of the input");
+
+	typedef typename std::make_unsigned<T>::type Unsigned;
+
+	/*! Number of breakpoints */
+	static constexpr std::size_t POINTS = (std::size_t(1) << Bits) + 1;
+
+	/*! Number of bits of the position within an interval */
+	static const int SHIFT = WIDTH - Bits;
+
+	/*!
+		\brief Input value of breakpoint k, the last one lying one interval past the largest input
+	*/
+	static constexpr double breakpoint(std::size_t k)
+	{
+		double lowest = std::numeric_limits<T>::is_signed ? -exactPower2(WIDTH - 1) : 0.0;
+		return (lowest + static_cast<double>(k) * exactPower2(SHIFT)) / exactPower2(F);
+	}
+
+	/*!
+		\brief Raw value measured from the lowest value of the format
+	*/
+	static Unsigned offset(const FixedPoint<T, F>& x)
+	{
+		Unsigned sign = std::numeric_limits<T>::is_signed ? static_cast<Unsigned>(Unsigned(1) << (WIDTH - 1)) : Unsigned(0);
+		return static_cast<Unsigned>(static_cast<Unsigned>(x.raw()) ^ sign);
+	}
+
+	static std::size_t index(Unsigned offset) { return static_cast<std::size_t>(offset >> SHIFT); }
+
+	/*!
+		\brief Position within the interval with the given number of fractional bits
+	*/
+	template <int P>
+	static std::int64_t position(Unsigned offset)
+	{
+		return static_cast<std::int64_t>(offset & ((Unsigned(1) << SHIFT) - 1)) >> (SHIFT - P);
+	}
+};
+
+/*!
+	\class LookupTable
+	\brief Table of a function sampled at uniform breakpoints over the whole range of a Fixed Point input format
+	\details Lookups find the interval from the high bits of the input and interpolate linearly or with a
+				Catmull-Rom cubic in integer arithmetic, so a lookup costs a shift, a load and a multiply and add.
+				Tables can be built at compile time from a constexpr function or from breakpoint values. The
+				cubic uses one breakpoint either side of the interval, extrapolated linearly beyond the ends, and
+				saturates where it overshoots the range of V.
+	\tparam T The Base type of the input, of at most 32 bits
+	\tparam F The number of fractional bits of the input
+	\tparam Bits The number of index bits, giving 2^Bits + 1 breakpoints
+	\tparam V The Base type of the tabulated values, of at most 32 bits
+	\tparam H The number of fractional bits of the tabulated values
+*/
+template <typename T, std::int8_t F, int Bits, typename V = T, std::int8_t H = F>
+class LookupTable
+{
+	static_assert(sizeof(V) <= 4, "The values of a lookup table must have a Base T of at most 32 bits");
+
+	typedef LookupTableAxis<T, F, Bits> Axis;
+
+	/*! Fractional bits of the position in linear interpolation, leaving room for the product with a difference */
+	static const int LINEAR_BITS = Axis::SHIFT < 61 - static_cast<int>(sizeof(V) * 8) ? Axis::SHIFT : 61 - static_cast<int>(sizeof(V) * 8);
+
+	/*! Fractional bits of the position in cubic interpolation */
+	static const int CUBIC_BITS = Axis::SHIFT < 16 ? Axis::SHIFT : 16;
+
+public:
+	typedef FixedPoint<T, F> input_type;
+	typedef FixedPoint<V, H> value_type;
+
+	static constexpr std::size_t POINTS = Axis::POINTS;
+
+	/*!
+		\brief Default constructor. Creates a table of zeros.
+	*/
+	constexpr LookupTable() = default;
+
+	/*!
+		\brief Create a table by sampling a function at every breakpoint
+		\param function Function from double to double, which may be constexpr
+	*/
+	template <typename Function>
+	static constexpr LookupTable<T, F, Bits, V, H> create(Function function);
+
+	/*!
+		\brief Create a table from the raw values at every breakpoint
+	*/
+	static constexpr LookupTable<T, F, Bits, V, H> createFromBreakpoints(const std::array<V, POINTS>& values);
+
+	/*!
+		\brief Input value of breakpoint k
+	*/
+	static constexpr double breakpoint(std::size_t k) { return Axis::breakpoint(k); }
+
+	/*!
+		\brief Raw value at breakpoint k
+	*/
+	constexpr V raw(std::size_t k) const { return _values[k + 1]; }
+
+	value_type linear(const input_type& x) const;
+	value_type cubic(const input_type& x) const;
+
+	/*!
+		\brief Interpolate linearly for every element of an array
+	*/
+	void linear(const input_type* in, value_type* out, std::size_t count) const;
+
+	/*!
+		\brief Interpolate with the cubic for every element of an array
+	*/
+	void cubic(const input_type* in, value_type* out, std::size_t count) const;
+
+private:
+	/*!
+		\brief Extrapolate the padding breakpoints either side of the table
+	*/
+	constexpr void pad();
+
+	/* Breakpoint k is held at k + 1, with the padding at each end */
+	std::array<V, POINTS + 2> _values = {};
+};
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+template <typename Function>
+constexpr LookupTable<T, F, Bits, V, H> LookupTable<T, F, Bits, V, H>::create(Function function)
+{
+	LookupTable<T, F, Bits, V, H> table;
+	for (std::size_t k = 0; k < POINTS; ++k)
+	{
+		table._values[k + 1] = fixedPointRaw<V, H>(function(breakpoint(k)));
+	}
+
+	table.pad();
+	return table;
+}
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+constexpr LookupTable<T, F, Bits, V, H> LookupTable<T, F, Bits, V, H>::createFromBreakpoints(const std::array<V, POINTS>& values)
+{
+	LookupTable<T, F, Bits, V, H> table;
+	for (std::size_t k = 0; k < POINTS; ++k)
+	{
+		table._values[k + 1] = values[k];
+	}
+
+	table.pad();
+	return table;
+}
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+constexpr void LookupTable<T, F, Bits, V, H>::pad()
+{
+	_values[0] = saturateRaw<V>(2 * static_cast<std::int64_t>(_values[1]) - _values[2]);
+	_values[POINTS + 1] = saturateRaw<V>(2 * static_cast<std::int64_t>(_values[POINTS]) - _values[POINTS - 1]);
+}
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+typename LookupTable<T, F, Bits, V, H>::value_type LookupTable<T, F, Bits, V, H>::linear(const input_type& x) const
+{
+	typename Axis::Unsigned offset = Axis::offset(x);
+	std::size_t i = Axis::index(offset) + 1;
+	std::int64_t t = Axis::template position<LINEAR_BITS>(offset);
+
+	std::int64_t y0 = _values[i];
+	std::int64_t y1 = _values[i + 1];
+
+	return value_type::createFixedPoint(static_cast<V>(y0 + (((y1 - y0) * t) >> LINEAR_BITS)));
+}
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+typename LookupTable<T, F, Bits, V, H>::value_type LookupTable<T, F, Bits, V, H>::cubic(const input_type& x) const
+{
+	typename Axis::Unsigned offset = Axis::offset(x);
+	std::size_t i = Axis::index(offset);
+	std::int64_t t = Axis::template position<CUBIC_BITS>(offset);
+
+	std::int64_t p0 = _values[i];
+	std::int64_t p1 = _values[i + 1];
+	std::int64_t p2 = _values[i + 2];
+	std::int64_t p3 = _values[i + 3];
+
+	/* Catmull-Rom: p1 + (a1 t + a2 t^2 + a3 t^3) / 2, evaluated with Horner's scheme */
+	std::int64_t a3 = 3 * (p1 - p2) + p3 - p0;
+	std::int64_t a2 = 2 * p0 - 5 * p1 + 4 * p2 - p3;
+	std::int64_t a1 = p2 - p0;
+
+	std::int64_t sum = (((((((a3 * t) >> CUBIC_BITS) + a2) * t) >> CUBIC_BITS) + a1) * t) >> CUBIC_BITS;
+
+	return value_type::createFixedPoint(saturateRaw<V>(p1 + (sum >> 1)));
+}
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+void LookupTable<T, F, Bits, V, H>::linear(const input_type* in, value_type* out, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = linear(in[i]);
+	}
+}
+
+template <typename T, std::int8_t F, int Bits, typename V, std::int8_t H>
+void LookupTable<T, F, Bits, V, H>::cubic(const input_type* in, value_type* out, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = cubic(in[i]);
+	}
+}
+
+/*!
+	\class LookupTable2D
+	\brief Table of a function of two inputs sampled on a uniform grid, with bilinear interpolation
+	\tparam T The Base type of both inputs, of at most 32 bits
+	\tparam F The number of fractional bits of both inputs
+	\tparam XBits The number of index bits of the first input
+	\tparam YBits The number of index bits of the second input
+	\tparam V The Base type of the tabulated values, of at most 32 bits
+	\tparam H The number of fractional bits of the tabulated values
+*/
+template <typename T, std::int8_t F, int XBits, int YBits, typename V = T, std::int8_t H = F>
+class LookupTable2D
+{
+	static_assert(sizeof(V) <= 4, "The values of a lookup table must have a Base T of at most 32 bits");
+
+	typedef LookupTableAxis<T, F, XBits> XAxis;
+	typedef LookupTableAxis<T, F, YBits> YAxis;
+
+	static const int X_BITS = XAxis::SHIFT < 61 - static_cast<int>(sizeof(V) * 8) ? XAxis::SHIFT : 61 - static_cast<int>(sizeof(V) * 8);
+	static const int Y_BITS = YAxis::SHIFT < 61 - static_cast<int>(sizeof(V) * 8) ? YAxis::SHIFT : 61 - static_cast<int>(sizeof(V) * 8);
+
+public:
+	typedef FixedPoint<T, F> input_type;
+	typedef FixedPoint<V, H> value_type;
+
+	static constexpr std::size_t X_POINTS = XAxis::POINTS;
+	static constexpr std::size_t Y_POINTS = YAxis::POINTS;
+
+	constexpr LookupTable2D() = default;
+
+	/*!
+		\brief Create a table by sampling a function at every grid point
+		\param function Function from two doubles to double, which may be constexpr
+	*/
+	template <typename Function>
+	static constexpr LookupTable2D<T, F, XBits, YBits, V, H> create(Function function);
+
+	/*!
+		\brief Raw value at grid point (i, j)
+	*/
+	constexpr V raw(std::size_t i, std::size_t j) const { return _values[i * Y_POINTS + j]; }
+
+	value_type bilinear(const input_type& x, const input_type& y) const;
+
+	/*!
+		\brief Interpolate for every pair of elements of two arrays
+	*/
+	void bilinear(const input_type* x, const input_type* y, value_type* out, std::size_t count) const;
+
+private:
+	std::array<V, X_POINTS * Y_POINTS> _values = {};
+};
+
+template <typename T, std::int8_t F, int XBits, int YBits, typename V, std::int8_t H>
+template <typename Function>
+constexpr LookupTable2D<T, F, XBits, YBits, V, H> LookupTable2D<T, F, XBits, YBits, V, H>::create(Function function)
+{
+	LookupTable2D<T, F, XBits, YBits, V, H> table;
+	for (std::size_t i = 0; i < X_POINTS; ++i)
+	{
+		for (std::size_t j = 0; j < Y_POINTS; ++j)
+		{
+			table._values[i * Y_POINTS + j] = fixedPointRaw<V, H>(function(XAxis::breakpoint(i), YAxis::breakpoint(j)));
+		}
+	}
+
+	return table;
+}
+
+template <typename T, std::int8_t F, int XBits, int YBits, typename V, std::int8_t H>
+typename LookupTable2D<T, F, XBits, YBits, V, H>::value_type LookupTable2D<T, F, XBits, YBits, V, H>::bilinear(const input_type& x, const input_type& y) const
+{
+	typename XAxis::Unsigned x_offset = XAxis::offset(x);
+	typename YAxis::Unsigned y_offset = YAxis::offset(y);
+
+	const V* row = _values.data() + XAxis::index(x_offset) * Y_POINTS + YAxis::index(y_offset);
+	std::int64_t u = XAxis::template position<X_BITS>(x_offset);
+	std::int64_t v = YAxis::template position<Y_BITS>(y_offset);
+
+	std::int64_t y00 = row[0];
+	std::int64_t y01 = row[1];
+	std::int64_t y10 = row[Y_POINTS];
+	std::int64_t y11 = row[Y_POINTS + 1];
+
+	std::int64_t low = y00 + (((y01 - y00) * v) >> Y_BITS);
+	std::int64_t high = y10 + (((y11 - y10) * v) >> Y_BITS);
+
+	return value_type::createFixedPoint(static_cast<V>(low + (((high - low) * u) >> X_BITS)));
+}
+
+template <typename T, std::int8_t F, int XBits, int YBits, typename V, std::int8_t H>
+void LookupTable2D<T, F, XBits, YBits, V, H>::bilinear(const input_type* x, const input_type* y, value_type* out, std::size_t count) const
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = bilinear(x[i], y[i]);
+	}
+}
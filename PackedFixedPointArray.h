@@ -0,0 +1,282 @@
+/*!
+ *  \file PackedFixedPointArray.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/*!
+	\class PackedFixedPointArray
+	\brief Array of Fixed Point numbers stored densely with Bits bits per element
+	\details Elements are packed least significant bit first into a little endian byte stream, so the layout is the
+				same on every platform and matches the usual packing of 12 and 24 bit sample formats. Values are
+				read and written as FixedPoint numbers of the next 16 or 32 bit type. Eight elements always fill
+				exactly Bits bytes, so unpack and pack work on groups of eight where every bit offset is a compile
+				time constant and the compiler can unroll and vectorise the group.
+	\tparam Bits The number of bits stored per element, from 2 to 32
+	\tparam F The number of fractional bits
+	\tparam Signed Whether the elements are signed two's complement
+*/
+template <int Bits, std::int8_t F, bool Signed>
+class PackedFixedPointArray
+{
+	static_assert(Bits >= 2 && Bits <= 32, "Bits must be between 2 and 32");
+	static_assert(F < Bits, "Fractional F must be smaller than the number of Bits");
+
+	/*! Number of elements in a group, which always fills a whole number of bytes */
+	static const std::size_t GROUP = 8;
+
+	/*! Bytes past the end of the packed data so that every element can be read with one 8 byte load */
+	static const std::size_t PADDING = 8;
+
+public:
+	/*! Integer type the elements are unpacked to */
+	typedef typename StorageSelector<(Bits <= 16 ? 16 : 32), Signed>::Type ValueType;
+
+	typedef FixedPoint<ValueType, F> value_type;
+
+	/*!
+		\brief Proxy to one packed element, allowing elements to be read and assigned through operator[]
+	*/
+	class Reference
+	{
+	public:
+		Reference(PackedFixedPointArray<Bits, F, Signed>& array, std::size_t index)
+				: _array(array), _index(index)
+		{}
+
+		operator value_type() const { return _array.get(_index); }
+
+		Reference& operator=(const value_type& value) { _array.set(_index, value); return *this; }
+		Reference& operator=(const Reference& rhs) { _array.set(_index, rhs._array.get(rhs._index)); return *this; }
+
+	private:
+		PackedFixedPointArray<Bits, F, Signed>& _array;
+		std::size_t _index;
+	};
+
+	/*!
+		\brief Default constructor.
+	*/
+	PackedFixedPointArray() = default;
+
+	/*!
+		\brief Parameterised constructor. Creates an array of zeros.
+		\param size The number of elements
+	*/
+	explicit PackedFixedPointArray(std::size_t size) { resize(size); }
+
+	std::size_t size() const { return _size; }
+
+	/*!
+		\brief Change the number of elements, new elements are zero
+		\param size The new number of elements
+	*/
+	void resize(std::size_t size);
+
+	/*!
+		\brief Number of bytes of packed data, excluding padding
+	*/
+	std::size_t bytes() const { return (_size * Bits + 7) / 8; }
+
+	const std::uint8_t* data() const { return _data.data(); }
+	std::uint8_t* data() { return _data.data(); }
+
+	value_type get(std::size_t index) const;
+	void set(std::size_t index, const value_type& value);
+
+	value_type operator[](std::size_t index) const { return get(index); }
+	Reference operator[](std::size_t index) { return Reference(*this, index); }
+
+	/*!
+		\brief Unpack a block of elements
+		\param first The index of the first element
+		\param count The number of elements
+		\param out The array to unpack to, of at least count elements
+	*/
+	void unpack(std::size_t first, std::size_t count, value_type* out) const;
+
+	/*!
+		\brief Pack a block of elements, values are truncated to Bits bits
+		\param first The index of the first element
+		\param count The number of elements
+		\param in The array to pack from, of at least count elements
+	*/
+	void pack(std::size_t first, std::size_t count, const value_type* in);
+
+private:
+	/*!
+		\brief Read 8 bytes as a little endian word
+	*/
+	static std::uint64_t load(const std::uint8_t* bytes);
+
+	/*!
+		\brief Write a word as 8 little endian bytes
+	*/
+	static void store(std::uint8_t* bytes, std::uint64_t word);
+
+	/*!
+		\brief Turn the low Bits bits of a word into an element, sign extending signed elements
+	*/
+	static value_type extract(std::uint64_t word);
+
+	void unpackGroup(std::size_t group, value_type* out) const;
+	void packGroup(std::size_t group, const value_type* in);
+
+	/*! Mask of the low Bits bits */
+	static const std::uint64_t MASK = (std::uint64_t(1) << Bits) - 1;
+
+	std::vector<std::uint8_t> _data = std::vector<std::uint8_t>(PADDING, 0);
+	std::size_t _size = 0;
+};
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::resize(std::size_t size)
+{
+	std::size_t old_bytes = bytes();
+	std::size_t old_size = _size;
+
+	_size = size;
+	_data.resize(bytes() + PADDING, 0);
+
+	if (size > old_size)
+	{
+		/* Clear the padding and any partial byte left over from the previous size */
+		std::memset(_data.data() + old_bytes, 0, _data.size() - old_bytes);
+		for (std::size_t i = old_size; i < size && (i * Bits) / 8 < old_bytes; ++i)
+		{
+			set(i, value_type());
+		}
+	}
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+std::uint64_t PackedFixedPointArray<Bits, F, Signed>::load(const std::uint8_t* bytes)
+{
+	std::uint64_t word = 0;
+	for (int i = 0; i < 8; ++i)
+	{
+		word |= std::uint64_t(bytes[i]) << (8 * i);
+	}
+
+	return word;
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::store(std::uint8_t* bytes, std::uint64_t word)
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		bytes[i] = static_cast<std::uint8_t>(word >> (8 * i));
+	}
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+typename PackedFixedPointArray<Bits, F, Signed>::value_type PackedFixedPointArray<Bits, F, Signed>::extract(std::uint64_t word)
+{
+	std::uint32_t bits = static_cast<std::uint32_t>(word & MASK);
+
+	if (Signed)
+	{
+		std::int32_t extended = static_cast<std::int32_t>(bits << (32 - Bits)) >> (32 - Bits);
+		return value_type::createFixedPoint(static_cast<ValueType>(extended));
+	}
+
+	return value_type::createFixedPoint(static_cast<ValueType>(bits));
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+typename PackedFixedPointArray<Bits, F, Signed>::value_type PackedFixedPointArray<Bits, F, Signed>::get(std::size_t index) const
+{
+	std::size_t bit = index * Bits;
+	return extract(load(_data.data() + bit / 8) >> (bit % 8));
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::set(std::size_t index, const value_type& value)
+{
+	std::size_t bit = index * Bits;
+	std::uint8_t* bytes = _data.data() + bit / 8;
+	int shift = static_cast<int>(bit % 8);
+
+	std::uint64_t word = load(bytes);
+	word &= ~(MASK << shift);
+	word |= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(value.raw())) & MASK) << shift;
+	store(bytes, word);
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::unpackGroup(std::size_t group, value_type* out) const
+{
+	const std::uint8_t* bytes = _data.data() + group * Bits;
+
+	for (std::size_t k = 0; k < GROUP; ++k)
+	{
+		out[k] = extract(load(bytes + (k * Bits) / 8) >> ((k * Bits) % 8));
+	}
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::packGroup(std::size_t group, const value_type* in)
+{
+	/* Assemble the group in a local buffer so the packed data is written once without being read */
+	std::uint8_t buffer[Bits + PADDING] = {};
+
+	for (std::size_t k = 0; k < GROUP; ++k)
+	{
+		std::uint64_t value = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(in[k].raw())) & MASK) << ((k * Bits) % 8);
+		std::uint8_t* bytes = buffer + (k * Bits) / 8;
+		store(bytes, load(bytes) | value);
+	}
+
+	std::memcpy(_data.data() + group * Bits, buffer, Bits);
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::unpack(std::size_t first, std::size_t count, value_type* out) const
+{
+	std::size_t index = first;
+	std::size_t end = first + count;
+
+	for (; index < end && index % GROUP != 0; ++index)
+	{
+		*out++ = get(index);
+	}
+
+	for (; index + GROUP <= end; index += GROUP, out += GROUP)
+	{
+		unpackGroup(index / GROUP, out);
+	}
+
+	for (; index < end; ++index)
+	{
+		*out++ = get(index);
+	}
+}
+
+template <int Bits, std::int8_t F, bool Signed>
+void PackedFixedPointArray<Bits, F, Signed>::pack(std::size_t first, std::size_t count, const value_type* in)
+{
+	std::size_t index = first;
+	std::size_t end = first + count;
+
+	for (; index < end && index % GROUP != 0; ++index)
+	{
+		set(index, *in++);
+	}
+
+	for (; index + GROUP <= end; index += GROUP, in += GROUP)
+	{
+		packGroup(index / GROUP, in);
+	}
+
+	for (; index < end; ++index)
+	{
+		set(index, *in++);
+	}
+}
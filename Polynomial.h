@@ -0,0 +1,278 @@
+/*!
+ *  \file Polynomial.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+/*!
+	\class BoundedPolynomial
+	\brief Polynomial with coefficients fixed at compile time, evaluated in fixed point for inputs of a known range
+	\details Coefficients are given as raw values of FixedPoint<T, F>, lowest degree first, since a FixedPoint can
+				not be a template argument. Every intermediate result is held in 64 bits with its own number of
+				fractional bits, chosen at compile time from the largest value it can reach for inputs up to the
+				Limit so that it keeps 31 significant bits and can not overflow. The rescale between steps is a
+				shift by a constant, and only the final result is truncated back to F fractional bits. Inputs
+				beyond the Limit give undefined results.
+	\tparam T The Base type of the input and result, of at most 32 bits
+	\tparam F The number of fractional bits of the input, result and coefficients
+	\tparam Limit The largest raw magnitude of an input
+	\tparam C The raw coefficients, from the constant term up
+*/
+template <typename T, std::int8_t F, T Limit, T... C>
+class BoundedPolynomial
+{
+	static_assert(sizeof...(C) > 0, "A Polynomial needs at least one coefficient");
+	static_assert(sizeof(T) <= 4, "Polynomial evaluation needs a Base T of at most 32 bits");
+
+public:
+	typedef FixedPoint<T, F> value_type;
+
+	/*! Number of coefficients, one more than the degree */
+	static constexpr std::size_t SIZE = sizeof...(C);
+
+	/*!
+		\brief Evaluate with Horner's scheme, one multiply and add per coefficient
+	*/
+	static value_type horner(const value_type& x);
+
+	/*!
+		\brief Evaluate with Estrin's scheme, which splits the polynomial into independent halves so more of the
+				multiplies can run in parallel
+	*/
+	static value_type estrin(const value_type& x);
+
+	value_type operator()(const value_type& x) const { return horner(x); }
+
+	/*!
+		\brief Evaluate for every element of an array
+		\param in The inputs
+		\param out The results, of at least count elements
+		\param count The number of elements
+	*/
+	static void evaluate(const value_type* in, value_type* out, std::size_t count);
+
+	/*!
+		\brief Number of fractional bits of the Horner intermediate holding coefficients k and above
+	*/
+	static constexpr int hornerFraction(std::size_t k) { return fraction(hornerBound(k)); }
+
+private:
+	static constexpr T coefficient(std::size_t k)
+	{
+		const T coefficients[] = { C... };
+		return coefficients[k];
+	}
+
+	static constexpr double magnitude(std::size_t k)
+	{
+		return (coefficient(k) < 0 ? -static_cast<double>(coefficient(k)) : static_cast<double>(coefficient(k))) / exactPower2(F);
+	}
+
+	/*!
+		\brief Number of fractional bits that keeps values up to bound within 31 bits plus sign
+		\details The bound is widened slightly so that rounding in its calculation can not hide an overflow
+	*/
+	static constexpr int fraction(double bound)
+	{
+		if (bound == 0.0)
+		{
+			return F;
+		}
+
+		int exponent = -62;
+		while (exponent < 62 && exactPower2(exponent) < bound * (1.0 + exactPower2(-40)))
+		{
+			++exponent;
+		}
+
+		return 31 - exponent < 62 ? 31 - exponent : 62;
+	}
+
+	/*! Largest magnitude of an input, allowing for the lowest signed value being one further from zero than the highest */
+	static constexpr double inputBound() { return (static_cast<double>(Limit < 0 ? -Limit : Limit) + 1.0) / exactPower2(F); }
+
+	static constexpr int inputFraction() { return fraction(inputBound()); }
+
+	static constexpr double hornerBound(std::size_t k)
+	{
+		double bound = 0.0;
+		for (std::size_t i = SIZE; i > k; --i)
+		{
+			bound = bound * inputBound() + magnitude(i - 1);
+		}
+
+		return bound;
+	}
+
+	/*!
+		\brief Largest magnitude of the Estrin partial result over coefficients [lo, lo + length)
+	*/
+	static constexpr double estrinBound(std::size_t lo, std::size_t length)
+	{
+		double bound = 0.0;
+		for (std::size_t i = (lo + length < SIZE ? lo + length : SIZE); i > lo; --i)
+		{
+			bound = bound * inputBound() + magnitude(i - 1);
+		}
+
+		return bound;
+	}
+
+	/*!
+		\brief Number of fractional bits of x^length, for length a power of two
+	*/
+	static constexpr int powerFraction(std::size_t length)
+	{
+		double bound = 1.0;
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			bound *= inputBound();
+		}
+
+		return fraction(bound);
+	}
+
+	/*! Smallest power of two of at least SIZE */
+	static constexpr std::size_t estrinLength()
+	{
+		std::size_t length = 1;
+		while (length < SIZE)
+		{
+			length <<= 1;
+		}
+
+		return length;
+	}
+
+	/*!
+		\brief Move a raw value to a format S fractional bits shorter, flooring, or -S bits longer
+	*/
+	template <int S>
+	static constexpr std::int64_t shiftBy(std::int64_t value)
+	{
+		if constexpr (S >= 63)
+		{
+			return value >> 63;
+		}
+		else if constexpr (S >= 0)
+		{
+			return value >> S;
+		}
+		else
+		{
+			return value * (std::int64_t(1) << -S);
+		}
+	}
+
+	/*!
+		\brief Apply the Horner steps below coefficient K to the intermediate holding coefficients K and above
+	*/
+	template <std::size_t K>
+	static std::int64_t hornerFrom(std::int64_t accumulator, std::int64_t x);
+
+	/*!
+		\brief Evaluate the coefficients [Lo, Lo + Length) with Estrin's scheme
+		\param powers The powers x^1, x^2, x^4, ... each in its own format
+	*/
+	template <std::size_t Lo, std::size_t Length>
+	static std::int64_t estrinOf(const std::int64_t* powers);
+};
+
+/*!
+	\brief Polynomial valid for every input of the FixedPoint<T, F> format
+	\details When the inputs are known to be smaller, a BoundedPolynomial keeps more precision in the intermediates
+*/
+template <typename T, std::int8_t F, T... C>
+using Polynomial = BoundedPolynomial<T, F, std::numeric_limits<T>::max(), C...>;
+
+template <typename T, std::int8_t F, T Limit, T... C>
+template <std::size_t K>
+std::int64_t BoundedPolynomial<T, F, Limit, C...>::hornerFrom(std::int64_t accumulator, std::int64_t x)
+{
+	if constexpr (K == 0)
+	{
+		return accumulator;
+	}
+	else
+	{
+		constexpr int Q = hornerFraction(K - 1);
+		constexpr std::int64_t c = shiftBy<F - Q>(coefficient(K - 1));
+
+		return hornerFrom<K - 1>(shiftBy<hornerFraction(K) + inputFraction() - Q>(accumulator * x) + c, x);
+	}
+}
+
+template <typename T, std::int8_t F, T Limit, T... C>
+typename BoundedPolynomial<T, F, Limit, C...>::value_type BoundedPolynomial<T, F, Limit, C...>::horner(const value_type& x)
+{
+	constexpr std::int64_t leading = shiftBy<F - hornerFraction(SIZE - 1)>(coefficient(SIZE - 1));
+
+	std::int64_t normalised = shiftBy<F - inputFraction()>(x.raw());
+	std::int64_t result = hornerFrom<SIZE - 1>(leading, normalised);
+
+	return value_type::createFixedPoint(static_cast<T>(shiftBy<hornerFraction(0) - F>(result)));
+}
+
+template <typename T, std::int8_t F, T Limit, T... C>
+template <std::size_t Lo, std::size_t Length>
+std::int64_t BoundedPolynomial<T, F, Limit, C...>::estrinOf(const std::int64_t* powers)
+{
+	constexpr int Q = fraction(estrinBound(Lo, Length));
+
+	if constexpr (Length == 1)
+	{
+		return shiftBy<F - Q>(coefficient(Lo));
+	}
+	else if constexpr (Lo + Length / 2 >= SIZE)
+	{
+		/* The upper half lies past the leading coefficient */
+		return shiftBy<fraction(estrinBound(Lo, Length / 2)) - Q>(estrinOf<Lo, Length / 2>(powers));
+	}
+	else
+	{
+		constexpr std::size_t HALF = Length / 2;
+		constexpr int LOW = fraction(estrinBound(Lo, HALF));
+		constexpr int HIGH = fraction(estrinBound(Lo + HALF, HALF));
+
+		std::int64_t power = powers[std::countr_zero(HALF)];
+		std::int64_t low = estrinOf<Lo, HALF>(powers);
+		std::int64_t high = estrinOf<Lo + HALF, HALF>(powers);
+
+		return shiftBy<LOW - Q>(low) + shiftBy<HIGH + powerFraction(HALF) - Q>(high * power);
+	}
+}
+
+template <typename T, std::int8_t F, T Limit, T... C>
+typename BoundedPolynomial<T, F, Limit, C...>::value_type BoundedPolynomial<T, F, Limit, C...>::estrin(const value_type& x)
+{
+	constexpr std::size_t LENGTH = estrinLength();
+	constexpr int LEVELS = LENGTH > 1 ? std::countr_zero(LENGTH) : 1;
+
+	std::int64_t powers[LEVELS];
+	powers[0] = shiftBy<F - inputFraction()>(x.raw());
+
+	[&]<std::size_t... J>(std::index_sequence<J...>)
+	{
+		((powers[J + 1] = shiftBy<2 * powerFraction(std::size_t(1) << J) - powerFraction(std::size_t(2) << J)>(powers[J] * powers[J])), ...);
+	}(std::make_index_sequence<LEVELS - 1>());
+
+	std::int64_t result = estrinOf<0, LENGTH>(powers);
+
+	return value_type::createFixedPoint(static_cast<T>(shiftBy<fraction(estrinBound(0, LENGTH)) - F>(result)));
+}
+
+template <typename T, std::int8_t F, T Limit, T... C>
+void BoundedPolynomial<T, F, Limit, C...>::evaluate(const value_type* in, value_type* out, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		out[i] = horner(in[i]);
+	}
+}
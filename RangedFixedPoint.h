@@ -0,0 +1,265 @@
+/*!
+ *  \file RangedFixedPoint.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+/*!
+	\brief Calculate the number of bits needed to hold every value of a range
+	\param min The lowest value of the range
+	\param max The highest value of the range
+	\returns The number of bits, including a sign bit when min is negative
+*/
+constexpr int rangeBits(std::int64_t min, std::int64_t max)
+{
+	int bits = 1;
+
+	if (min < 0)
+	{
+		while (bits < 64 && (min < -(std::int64_t(1) << (bits - 1)) || max > (std::int64_t(1) << (bits - 1)) - 1))
+		{
+			++bits;
+		}
+
+		return bits;
+	}
+
+	while (bits < 64 && (max >> bits) != 0)
+	{
+		++bits;
+	}
+
+	return bits;
+}
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+class RangedFixedPoint;
+
+/*!
+	\brief Selects the smallest RangedFixedPoint able to hold a range
+	\tparam F The number of fractional bits
+	\tparam Min The lowest raw value of the range
+	\tparam Max The highest raw value of the range
+*/
+template <std::int8_t F, std::int64_t Min, std::int64_t Max>
+struct RangedSelector
+{
+	static const int BITS = rangeBits(Min, Max);
+	static_assert(BITS <= 32, "The range of the result can not be held by a 32 bit Fixed Point");
+
+	typedef RangedFixedPoint<typename StorageSelector<BITS <= 32 ? BITS : 32, (Min < 0)>::Type, F, Min, Max> Type;
+};
+
+/*!
+	\brief Bounds and result types of arithmetic between two RangedFixedPoint numbers
+	\details The result keeps the larger of the two fractional amounts. Bounds are exact, products use the same
+				truncating shift as the run time calculation.
+*/
+template <std::int8_t F, std::int64_t AMin, std::int64_t AMax, std::int8_t G, std::int64_t BMin, std::int64_t BMax>
+struct RangedArithmetic
+{
+	static const std::int8_t H = F > G ? F : G;
+	static const int A_SHIFT = H - F;
+	static const int B_SHIFT = H - G;
+
+	static constexpr std::int64_t SUM_MIN = AMin * (std::int64_t(1) << A_SHIFT) + BMin * (std::int64_t(1) << B_SHIFT);
+	static constexpr std::int64_t SUM_MAX = AMax * (std::int64_t(1) << A_SHIFT) + BMax * (std::int64_t(1) << B_SHIFT);
+
+	static constexpr std::int64_t DIFFERENCE_MIN = AMin * (std::int64_t(1) << A_SHIFT) - BMax * (std::int64_t(1) << B_SHIFT);
+	static constexpr std::int64_t DIFFERENCE_MAX = AMax * (std::int64_t(1) << A_SHIFT) - BMin * (std::int64_t(1) << B_SHIFT);
+
+	static constexpr std::int64_t P0 = AMin * BMin;
+	static constexpr std::int64_t P1 = AMin * BMax;
+	static constexpr std::int64_t P2 = AMax * BMin;
+	static constexpr std::int64_t P3 = AMax * BMax;
+
+	/*! Bounds of the full precision product with F + G fractional bits */
+	static constexpr std::int64_t PRODUCT_MIN = P0 < P1 ? (P0 < P2 ? (P0 < P3 ? P0 : P3) : (P2 < P3 ? P2 : P3))
+														: (P1 < P2 ? (P1 < P3 ? P1 : P3) : (P2 < P3 ? P2 : P3));
+	static constexpr std::int64_t PRODUCT_MAX = P0 > P1 ? (P0 > P2 ? (P0 > P3 ? P0 : P3) : (P2 > P3 ? P2 : P3))
+														: (P1 > P2 ? (P1 > P3 ? P1 : P3) : (P2 > P3 ? P2 : P3));
+	static const int PRODUCT_SHIFT = F + G - H;
+
+	static constexpr std::int64_t MULTIPLY_MIN = PRODUCT_MIN >> PRODUCT_SHIFT;
+	static constexpr std::int64_t MULTIPLY_MAX = PRODUCT_MAX >> PRODUCT_SHIFT;
+
+	/*! The smallest type holding the full precision product */
+	typedef typename StorageSelector<rangeBits(PRODUCT_MIN, PRODUCT_MAX), (PRODUCT_MIN < 0)>::Type Product;
+
+	typedef typename RangedSelector<H, SUM_MIN, SUM_MAX>::Type Sum;
+	typedef typename RangedSelector<H, DIFFERENCE_MIN, DIFFERENCE_MAX>::Type Difference;
+	typedef typename RangedSelector<H, MULTIPLY_MIN, MULTIPLY_MAX>::Type Multiply;
+};
+
+/*!
+	\class RangedFixedPoint
+	\brief Templated class to handle Fixed Point arithmetic where the range of values is known at compile time
+	\details The bounds are carried in the type and propagated through arithmetic, so every result type is the
+				smallest storage that can hold the result and no overflow is possible. A result that would need
+				more than 32 bits fails to compile. As the bounds are proven there is no saturation or checking at
+				run time, values are only clamped on entry through createClamped.
+	\tparam T The integer type holding the raw data, which must be able to hold the whole range
+	\tparam F The number of fractional bits
+	\tparam Min The lowest raw value, in units of 2^-F
+	\tparam Max The highest raw value, in units of 2^-F
+*/
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+class RangedFixedPoint
+{
+	static_assert(Min <= Max, "The Min of the range may not be larger than the Max");
+	static_assert(Min >= static_cast<std::int64_t>(std::numeric_limits<T>::min()) &&
+				  Max <= static_cast<std::int64_t>(std::numeric_limits<T>::max()), "The range must fit within the Base T");
+
+public:
+	/*! The lowest raw value */
+	static constexpr std::int64_t MIN = Min;
+
+	/*! The highest raw value */
+	static constexpr std::int64_t MAX = Max;
+
+	/*!
+		\brief Default constructor. The value is zero, or the bound nearest to zero when zero is outside the range.
+	*/
+	RangedFixedPoint() = default;
+
+	T raw() const { return _data; }
+
+	/*!
+		\brief Get the value as an unbounded fixed point number
+		\returns The fixed point number holding the same raw data
+	*/
+	FixedPoint<T, F> value() const { return FixedPoint<T, F>::createFixedPoint(_data); }
+
+	double toDouble() const { return value().toDouble(); }
+
+	/*!
+		\brief Creates a ranged fixed point from a fixed point number, clamping the value into the range
+		\param value The fixed point number
+		\param location The location of the caller, recorded against any saturation when
+					FIXEDPOINT_INSTRUMENTATION is defined
+		\returns The ranged fixed point number
+	*/
+	static RangedFixedPoint<T, F, Min, Max> createClamped(const FixedPoint<T, F>& value,
+														  const FixedPointLocation& location = FixedPointLocation::current());
+
+	/*!
+		\brief Creates a ranged fixed point from a raw value that is checked against the range at compile time
+		\tparam Raw The raw data to be stored
+		\returns The ranged fixed point number
+	*/
+	template <std::int64_t Raw>
+	static RangedFixedPoint<T, F, Min, Max> createConstant();
+
+	template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+	typename RangedArithmetic<F, Min, Max, G, MinB, MaxB>::Sum operator+(const RangedFixedPoint<U, G, MinB, MaxB>& rhs) const;
+
+	template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+	typename RangedArithmetic<F, Min, Max, G, MinB, MaxB>::Difference operator-(const RangedFixedPoint<U, G, MinB, MaxB>& rhs) const;
+
+	/*!
+		\brief Multiply, the product is formed at full precision in the smallest type that can hold it and
+				shifted once to the larger of the two fractional amounts
+	*/
+	template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+	typename RangedArithmetic<F, Min, Max, G, MinB, MaxB>::Multiply operator*(const RangedFixedPoint<U, G, MinB, MaxB>& rhs) const;
+
+	typename RangedSelector<F, -Max, -Min>::Type operator-() const;
+
+private:
+	/*!
+		The templated integer number representing the fixed point
+	*/
+	T _data = static_cast<T>(Min > 0 ? Min : (Max < 0 ? Max : 0));
+
+	template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+	friend class RangedFixedPoint;
+};
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+RangedFixedPoint<T, F, Min, Max> RangedFixedPoint<T, F, Min, Max>::createClamped(const FixedPoint<T, F>& value,
+																				 [[maybe_unused]] const FixedPointLocation& location)
+{
+	std::int64_t raw = value.raw();
+	FIXEDPOINT_INSTRUMENT(if (raw < Min || raw > Max) { FixedPointInstrumentation::recordSaturation(location); });
+
+	RangedFixedPoint<T, F, Min, Max> ranged;
+	ranged._data = static_cast<T>(raw < Min ? Min : (raw > Max ? Max : raw));
+	return ranged;
+}
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+template <std::int64_t Raw>
+RangedFixedPoint<T, F, Min, Max> RangedFixedPoint<T, F, Min, Max>::createConstant()
+{
+	static_assert(Raw >= Min && Raw <= Max, "The constant is outside of the range");
+
+	RangedFixedPoint<T, F, Min, Max> ranged;
+	ranged._data = static_cast<T>(Raw);
+	return ranged;
+}
+
+/*
+	The sums and differences are calculated modulo 2^32. As the bounds prove that the result fits within the result
+	type the low bits are exact, and no intermediate type wider than the operands is needed.
+*/
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+typename RangedArithmetic<F, Min, Max, G, MinB, MaxB>::Sum
+RangedFixedPoint<T, F, Min, Max>::operator+(const RangedFixedPoint<U, G, MinB, MaxB>& rhs) const
+{
+	typedef RangedArithmetic<F, Min, Max, G, MinB, MaxB> A;
+	typedef typename A::Sum R;
+
+	std::uint32_t lhs_raw = static_cast<std::uint32_t>(_data) << A::A_SHIFT;
+	std::uint32_t rhs_raw = static_cast<std::uint32_t>(rhs._data) << A::B_SHIFT;
+
+	R result;
+	result._data = static_cast<decltype(result._data)>(lhs_raw + rhs_raw);
+	return result;
+}
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+typename RangedArithmetic<F, Min, Max, G, MinB, MaxB>::Difference
+RangedFixedPoint<T, F, Min, Max>::operator-(const RangedFixedPoint<U, G, MinB, MaxB>& rhs) const
+{
+	typedef RangedArithmetic<F, Min, Max, G, MinB, MaxB> A;
+	typedef typename A::Difference R;
+
+	std::uint32_t lhs_raw = static_cast<std::uint32_t>(_data) << A::A_SHIFT;
+	std::uint32_t rhs_raw = static_cast<std::uint32_t>(rhs._data) << A::B_SHIFT;
+
+	R result;
+	result._data = static_cast<decltype(result._data)>(lhs_raw - rhs_raw);
+	return result;
+}
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+template <typename U, std::int8_t G, std::int64_t MinB, std::int64_t MaxB>
+typename RangedArithmetic<F, Min, Max, G, MinB, MaxB>::Multiply
+RangedFixedPoint<T, F, Min, Max>::operator*(const RangedFixedPoint<U, G, MinB, MaxB>& rhs) const
+{
+	typedef RangedArithmetic<F, Min, Max, G, MinB, MaxB> A;
+	typedef typename A::Multiply R;
+	typedef typename A::Product P;
+
+	/* Raws of up to 32 bits multiply exactly in 64 bits whatever the signs, and the product fits P by construction */
+	P product = static_cast<P>(static_cast<std::int64_t>(_data) * static_cast<std::int64_t>(rhs._data));
+
+	R result;
+	result._data = static_cast<decltype(result._data)>(product >> A::PRODUCT_SHIFT);
+	return result;
+}
+
+template <typename T, std::int8_t F, std::int64_t Min, std::int64_t Max>
+typename RangedSelector<F, -Max, -Min>::Type RangedFixedPoint<T, F, Min, Max>::operator-() const
+{
+	typedef typename RangedSelector<F, -Max, -Min>::Type R;
+
+	R result;
+	result._data = static_cast<decltype(result._data)>(std::uint32_t(0) - static_cast<std::uint32_t>(_data));
+	return result;
+}
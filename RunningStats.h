@@ -0,0 +1,495 @@
+/*!
+ *  \file RunningStats.h
+ */
+
+#pragma once
+
+#include "FixedPoint.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/*!
+	\class RunningStats
+	\brief Single pass count, mean, variance, standard deviation, RMS, minimum and maximum of Fixed Point samples
+	\details The sum and the sum of squares of the raw values are kept exactly in 128 bit integers, so any number
+				of partials merge without error in any order. Derived statistics are computed from the exact sums
+				with integer arithmetic only, rounded to nearest and saturated to the format. Every statistic of
+				an empty set is zero.
+	\tparam T The Base type, of at most 32 bits
+	\tparam F The number of fractional bits
+*/
+template <typename T, std::int8_t F>
+class RunningStats
+{
+	static_assert(sizeof(T) <= 4, "The sum of squares is exact for Base types of at most 32 bits");
+
+public:
+	typedef FixedPoint<T, F> value_type;
+
+	/*! Samples summed in 64 bit lanes by the batch form before flushing to the 128 bit sums */
+	static const std::size_t BLOCK = std::size_t(1) << 30;
+
+	RunningStats();
+
+	/*!
+		\brief Create statistics from accumulated raw sums, as kept by SlidingStats
+	*/
+	static RunningStats createRunningStats(std::uint64_t count, __int128 sum, unsigned __int128 squares, T minimum, T maximum);
+
+	void add(const value_type& sample);
+
+	/*!
+		\brief Add an array of samples
+		\details Sums are kept in 64 bit lanes for blocks of samples. 32 bit samples are squared in 16 bit halves,
+					so every lane fits 64 bits and the loop vectorises.
+	*/
+	void add(const value_type* samples, std::size_t count);
+
+	/*!
+		\brief Combine the statistics of another set of samples, for example from another thread or window
+	*/
+	void merge(const RunningStats& other);
+
+	void reset();
+
+	std::uint64_t count() const { return _count; }
+
+	/*! Exact sum of the raw values */
+	__int128 sum() const { return _sum; }
+
+	/*! Exact sum of the squares of the raw values */
+	unsigned __int128 sumSquares() const { return _squares; }
+
+	value_type min() const { return value_type::createFixedPoint(_count == 0 ? T(0) : _min); }
+	value_type max() const { return value_type::createFixedPoint(_count == 0 ? T(0) : _max); }
+
+	value_type mean() const;
+
+	/*!
+		\brief The population variance, the mean squared deviation from the mean
+	*/
+	value_type variance() const;
+
+	/*!
+		\brief The sample variance, with Bessel's correction
+	*/
+	value_type sampleVariance() const;
+
+	/*!
+		\brief The population standard deviation
+	*/
+	value_type standardDeviation() const;
+
+	/*!
+		\brief The root mean square
+	*/
+	value_type rms() const;
+
+private:
+	/*!
+		\brief The mean raw value rounded to nearest, with ties away from zero
+	*/
+	__int128 roundedMean() const;
+
+	/*!
+		\brief The sum of squared deviations from the mean in raw units, truncated
+	*/
+	unsigned __int128 deviations() const;
+
+	/*!
+		\brief numerator / denominator rounded to nearest and saturated to the format
+	*/
+	static value_type saturatedQuotient(unsigned __int128 numerator, unsigned __int128 denominator);
+
+	/*!
+		\brief sqrt(n) rounded to nearest
+	*/
+	static std::uint64_t squareRoot(std::uint64_t n);
+
+	std::uint64_t _count;
+	__int128 _sum;
+	unsigned __int128 _squares;
+	T _min;
+	T _max;
+};
+
+template <typename T, std::int8_t F>
+RunningStats<T, F>::RunningStats()
+{
+	reset();
+}
+
+template <typename T, std::int8_t F>
+RunningStats<T, F> RunningStats<T, F>::createRunningStats(std::uint64_t count, __int128 sum, unsigned __int128 squares, T minimum, T maximum)
+{
+	RunningStats stats;
+	stats._count = count;
+	stats._sum = sum;
+	stats._squares = squares;
+	stats._min = minimum;
+	stats._max = maximum;
+
+	return stats;
+}
+
+template <typename T, std::int8_t F>
+void RunningStats<T, F>::reset()
+{
+	_count = 0;
+	_sum = 0;
+	_squares = 0;
+	_min = std::numeric_limits<T>::max();
+	_max = std::numeric_limits<T>::min();
+}
+
+template <typename T, std::int8_t F>
+void RunningStats<T, F>::add(const value_type& sample)
+{
+	std::int64_t raw = sample.raw();
+
+	/* Squares of values below 2^32 in magnitude are exact modulo 2^64 */
+	++_count;
+	_sum += raw;
+	_squares += static_cast<std::uint64_t>(raw) * static_cast<std::uint64_t>(raw);
+	_min = std::min(_min, sample.raw());
+	_max = std::max(_max, sample.raw());
+}
+
+template <typename T, std::int8_t F>
+void RunningStats<T, F>::add(const value_type* samples, std::size_t count)
+{
+	for (std::size_t first = 0; first < count; first += BLOCK)
+	{
+		std::size_t last = std::min(count, first + BLOCK);
+
+		std::int64_t sum = 0;
+		std::uint64_t low = 0;
+		std::uint64_t high = 0;
+		std::int64_t cross = 0;
+		T minimum = _min;
+		T maximum = _max;
+
+		if constexpr (sizeof(T) <= 2)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				std::int64_t raw = samples[i].raw();
+				sum += raw;
+				low += static_cast<std::uint64_t>(raw) * static_cast<std::uint64_t>(raw);
+				minimum = std::min(minimum, samples[i].raw());
+				maximum = std::max(maximum, samples[i].raw());
+			}
+		}
+		else
+		{
+			/* raw = h * 2^16 + l, so raw^2 = h^2 * 2^32 + 2 h l * 2^16 + l^2 */
+			for (std::size_t i = first; i < last; ++i)
+			{
+				std::int64_t raw = samples[i].raw();
+				std::int64_t h = raw >> 16;
+				std::int64_t l = raw & 0xFFFF;
+
+				sum += raw;
+				high += static_cast<std::uint64_t>(h * h);
+				cross += h * l;
+				low += static_cast<std::uint64_t>(l * l);
+				minimum = std::min(minimum, samples[i].raw());
+				maximum = std::max(maximum, samples[i].raw());
+			}
+		}
+
+		_count += last - first;
+		_sum += sum;
+		_squares += (static_cast<unsigned __int128>(high) << 32) + static_cast<unsigned __int128>(static_cast<__int128>(cross) * (1 << 17)) + low;
+		_min = minimum;
+		_max = maximum;
+	}
+}
+
+template <typename T, std::int8_t F>
+void RunningStats<T, F>::merge(const RunningStats& other)
+{
+	_count += other._count;
+	_sum += other._sum;
+	_squares += other._squares;
+	_min = std::min(_min, other._min);
+	_max = std::max(_max, other._max);
+}
+
+template <typename T, std::int8_t F>
+__int128 RunningStats<T, F>::roundedMean() const
+{
+	__int128 n = static_cast<__int128>(_count);
+	__int128 mean = _sum / n;
+	__int128 remainder = _sum % n;
+
+	if (2 * (remainder < 0 ? -remainder : remainder) >= n)
+	{
+		mean += remainder < 0 ? -1 : 1;
+	}
+
+	return mean;
+}
+
+template <typename T, std::int8_t F>
+unsigned __int128 RunningStats<T, F>::deviations() const
+{
+	/*
+	 * With m the rounded mean and e = sum - n m, the sum of (x - sum / n)^2 is
+	 * sum(x^2) - 2 m sum + n m^2 - e^2 / n. The first three terms are evaluated modulo 2^128, which is exact
+	 * as their total is the sum of (x - m)^2, and |e| is at most n / 2 so e^2 fits.
+	 */
+	__int128 m = roundedMean();
+	__int128 e = _sum - static_cast<__int128>(_count) * m;
+
+	unsigned __int128 centred = _squares - 2 * static_cast<unsigned __int128>(m) * static_cast<unsigned __int128>(_sum)
+			+ static_cast<unsigned __int128>(_count) * static_cast<unsigned __int128>(m * m);
+
+	return centred - static_cast<unsigned __int128>(e * e) / _count;
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> RunningStats<T, F>::saturatedQuotient(unsigned __int128 numerator, unsigned __int128 denominator)
+{
+	unsigned __int128 quotient = numerator / denominator;
+	if (2 * (numerator % denominator) >= denominator)
+	{
+		++quotient;
+	}
+
+	unsigned __int128 limit = static_cast<unsigned __int128>(std::numeric_limits<T>::max());
+	return value_type::createFixedPoint(static_cast<T>(std::min(quotient, limit)));
+}
+
+template <typename T, std::int8_t F>
+std::uint64_t RunningStats<T, F>::squareRoot(std::uint64_t n)
+{
+	std::uint64_t root = 0;
+	std::uint64_t bit = std::uint64_t(1) << 62;
+
+	while (bit > n)
+	{
+		bit >>= 2;
+	}
+
+	while (bit != 0)
+	{
+		if (n >= root + bit)
+		{
+			n -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+
+		bit >>= 2;
+	}
+
+	/* n is now the remainder of the floor, and rounding up is nearer when it exceeds the root */
+	return n > root ? root + 1 : root;
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> RunningStats<T, F>::mean() const
+{
+	return value_type::createFixedPoint(_count == 0 ? T(0) : static_cast<T>(roundedMean()));
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> RunningStats<T, F>::variance() const
+{
+	if (_count == 0)
+	{
+		return value_type::createFixedPoint(0);
+	}
+
+	return saturatedQuotient(deviations(), static_cast<unsigned __int128>(_count) << F);
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> RunningStats<T, F>::sampleVariance() const
+{
+	if (_count < 2)
+	{
+		return value_type::createFixedPoint(0);
+	}
+
+	return saturatedQuotient(deviations(), static_cast<unsigned __int128>(_count - 1) << F);
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> RunningStats<T, F>::standardDeviation() const
+{
+	if (_count == 0)
+	{
+		return value_type::createFixedPoint(0);
+	}
+
+	std::uint64_t root = squareRoot(static_cast<std::uint64_t>(deviations() / _count));
+	return value_type::createFixedPoint(static_cast<T>(std::min<std::uint64_t>(root, static_cast<std::uint64_t>(std::numeric_limits<T>::max()))));
+}
+
+template <typename T, std::int8_t F>
+FixedPoint<T, F> RunningStats<T, F>::rms() const
+{
+	if (_count == 0)
+	{
+		return value_type::createFixedPoint(0);
+	}
+
+	std::uint64_t root = squareRoot(static_cast<std::uint64_t>(_squares / _count));
+	return value_type::createFixedPoint(static_cast<T>(std::min<std::uint64_t>(root, static_cast<std::uint64_t>(std::numeric_limits<T>::max()))));
+}
+
+/*!
+	\class SlidingStats
+	\brief RunningStats over the most recent samples of a stream
+	\details Each sample updates the exact sums by adding itself and subtracting the sample leaving the window, and
+				the minimum and maximum are kept in monotonic queues, so each sample costs amortised constant time
+				whatever the length of the window.
+	\tparam T The Base type, of at most 32 bits
+	\tparam F The number of fractional bits
+*/
+template <typename T, std::int8_t F>
+class SlidingStats
+{
+public:
+	typedef FixedPoint<T, F> value_type;
+
+	/*!
+		\brief Parameterised constructor.
+		\param window The number of most recent samples, at least one
+	*/
+	explicit SlidingStats(std::size_t window);
+
+	std::size_t window() const { return _samples.size(); }
+
+	/*!
+		\brief The number of samples in the window, less than the window only at the start
+	*/
+	std::size_t size() const { return static_cast<std::size_t>(std::min<std::uint64_t>(_total, _samples.size())); }
+
+	void add(const value_type& sample);
+	void add(const value_type* samples, std::size_t count);
+
+	void reset();
+
+	/*!
+		\brief The statistics of the samples in the window
+	*/
+	RunningStats<T, F> stats() const;
+
+private:
+	/*!
+		\brief Queue of sample numbers whose values are monotonic, in a ring the size of the window
+	*/
+	struct MonotonicQueue
+	{
+		std::vector<std::uint64_t> entries;
+		std::size_t head = 0;
+		std::size_t size = 0;
+
+		std::uint64_t front() const { return entries[head]; }
+		std::uint64_t back() const { return entries[(head + size - 1) % entries.size()]; }
+		void popFront() { head = (head + 1) % entries.size(); --size; }
+		void popBack() { --size; }
+		void pushBack(std::uint64_t entry) { entries[(head + size++) % entries.size()] = entry; }
+	};
+
+	T raw(std::uint64_t number) const { return _samples[number % _samples.size()]; }
+
+	std::vector<T> _samples;
+
+	/*! Samples seen since the last reset */
+	std::uint64_t _total;
+
+	__int128 _sum;
+	unsigned __int128 _squares;
+	MonotonicQueue _minimums;
+	MonotonicQueue _maximums;
+};
+
+template <typename T, std::int8_t F>
+SlidingStats<T, F>::SlidingStats(std::size_t window)
+		: _samples(std::max<std::size_t>(1, window))
+{
+	_minimums.entries.resize(_samples.size());
+	_maximums.entries.resize(_samples.size());
+	reset();
+}
+
+template <typename T, std::int8_t F>
+void SlidingStats<T, F>::reset()
+{
+	_total = 0;
+	_sum = 0;
+	_squares = 0;
+	_minimums.head = _minimums.size = 0;
+	_maximums.head = _maximums.size = 0;
+}
+
+template <typename T, std::int8_t F>
+void SlidingStats<T, F>::add(const value_type& sample)
+{
+	const std::size_t WINDOW = _samples.size();
+	std::int64_t value = sample.raw();
+
+	if (_total >= WINDOW)
+	{
+		std::int64_t leaving = raw(_total - WINDOW);
+		_sum -= leaving;
+		_squares -= static_cast<std::uint64_t>(leaving) * static_cast<std::uint64_t>(leaving);
+
+		if (_minimums.front() == _total - WINDOW)
+		{
+			_minimums.popFront();
+		}
+
+		if (_maximums.front() == _total - WINDOW)
+		{
+			_maximums.popFront();
+		}
+	}
+
+	_samples[_total % WINDOW] = sample.raw();
+	_sum += value;
+	_squares += static_cast<std::uint64_t>(value) * static_cast<std::uint64_t>(value);
+
+	while (_minimums.size > 0 && raw(_minimums.back()) >= sample.raw())
+	{
+		_minimums.popBack();
+	}
+
+	while (_maximums.size > 0 && raw(_maximums.back()) <= sample.raw())
+	{
+		_maximums.popBack();
+	}
+
+	_minimums.pushBack(_total);
+	_maximums.pushBack(_total);
+	++_total;
+}
+
+template <typename T, std::int8_t F>
+void SlidingStats<T, F>::add(const value_type* samples, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		add(samples[i]);
+	}
+}
+
+template <typename T, std::int8_t F>
+RunningStats<T, F> SlidingStats<T, F>::stats() const
+{
+	if (_total == 0)
+	{
+		return RunningStats<T, F>();
+	}
+
+	return RunningStats<T, F>::createRunningStats(size(), _sum, _squares, raw(_minimums.front()), raw(_maximums.front()));
+}
@@ -0,0 +1,98 @@
+/*!
+    \file UnitTestAngle.cpp
+    \created 18/10/2026
+*/
+
+#include <Angle.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+TEST(Angle, WrapAround)
+{
+	/*
+	 * A signed 16 bit angle covers [-pi, pi) so a quarter revolution is 0x4000 and a half revolution wraps to
+	 * the lowest value
+	 */
+	Angle<std::int16_t> quarter = Angle<std::int16_t>::createAngle(0x4000);
+	Angle<std::int16_t> half = quarter + quarter;
+	EXPECT_EQ(std::numeric_limits<std::int16_t>::min(), half.raw());
+
+	Angle<std::int16_t> full = half + half;
+	EXPECT_EQ(0, full.raw());
+
+	Angle<std::int16_t> three_quarters = quarter * 3;
+	EXPECT_EQ(-quarter, three_quarters);
+	EXPECT_EQ(quarter, Angle<std::int16_t>() - three_quarters);
+
+	Angle<std::uint8_t> heading = Angle<std::uint8_t>::createAngle(250);
+	heading += Angle<std::uint8_t>::createAngle(10);
+	EXPECT_EQ(4, heading.raw());
+	heading -= Angle<std::uint8_t>::createAngle(8);
+	EXPECT_EQ(252, heading.raw());
+}
+
+TEST(Angle, Radians)
+{
+	typedef FixedPoint<std::int32_t, 24> S32F24;
+
+	/*
+	 * Conversions from radians wrap any number of revolutions into one. One step of F24 radians is about 41
+	 * steps of a 32 bit angle
+	 */
+	Angle<std::int32_t> a(S32F24(M_PI / 2.0));
+	EXPECT_NEAR(0x40000000, a.raw(), 64);
+
+	Angle<std::int32_t> b(S32F24(M_PI / 2.0 + 4.0 * M_PI));
+	EXPECT_NEAR(0x40000000, b.raw(), 64);
+
+	Angle<std::int32_t> c(S32F24(-M_PI / 2.0));
+	EXPECT_NEAR(-0x40000000, c.raw(), 64);
+
+	Angle<std::uint16_t> d(S32F24(-M_PI / 2.0));
+	EXPECT_NEAR(0xC000, d.raw(), 1);
+
+	/*
+	 * And back again, signed angles read as [-pi, pi) and unsigned as [0, 2pi)
+	 */
+	EXPECT_NEAR(-M_PI / 2.0, (c.toRadians<std::int32_t, 24>().toDouble()), 1e-6);
+	EXPECT_NEAR(3.0 * M_PI / 2.0, (d.toRadians<std::int32_t, 24>().toDouble()), 1e-4);
+
+	Angle<std::int16_t> e = Angle<std::int16_t>::createAngle(std::numeric_limits<std::int16_t>::min());
+	EXPECT_NEAR(-M_PI, (e.toRadians<std::int16_t, 12>().toDouble()), 1.0 / 4096);
+
+	/*
+	 * Unsigned 32 bit angles past half a revolution
+	 */
+	Angle<std::uint32_t> f = Angle<std::uint32_t>::createAngle(0xC0000000u);
+	EXPECT_NEAR(3.0 * M_PI / 2.0, (f.toRadians<std::int32_t, 24>().toDouble()), 1e-6);
+
+	Angle<std::uint32_t> g = Angle<std::uint32_t>::createAngle(0xFFFFFFFFu);
+	EXPECT_NEAR(2.0 * M_PI, (g.toRadians<std::int32_t, 24>().toDouble()), 1e-6);
+}
+
+TEST(Angle, Trigonometry)
+{
+	/*
+	 * Check the table interpolation across the whole circle against the standard library
+	 */
+	for (std::int32_t i = -32768; i < 32768; i += 97)
+	{
+		Angle<std::int16_t> angle = Angle<std::int16_t>::createAngle(std::int16_t(i));
+		double radians = i * M_PI / 32768.0;
+
+		EXPECT_NEAR(std::sin(radians), (angle.sin<std::int32_t, 30>().toDouble()), 1e-5);
+		EXPECT_NEAR(std::cos(radians), (angle.cos<std::int32_t, 30>().toDouble()), 1e-5);
+	}
+
+	Angle<std::uint32_t> quarter = Angle<std::uint32_t>::createAngle(0x40000000u);
+	EXPECT_EQ((FixedPoint<std::int16_t, 14>(1.0)), (quarter.sin<std::int16_t, 14>()));
+	EXPECT_EQ((FixedPoint<std::int16_t, 14>(0.0)), (quarter.cos<std::int16_t, 14>()));
+
+	/*
+	 * 8 bit angles index the table directly without interpolation
+	 */
+	Angle<std::int8_t> eighth = Angle<std::int8_t>::createAngle(32);
+	EXPECT_NEAR(std::sqrt(0.5), (eighth.sin<std::int32_t, 30>().toDouble()), 1e-9);
+}
@@ -0,0 +1,204 @@
+/*!
+    \file UnitTestComplexFixedPoint.cpp
+    \created 18/10/2026
+*/
+
+#include <ComplexFixedPoint.h>
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <vector>
+
+/*
+	CS16F15
+	C = Complex
+	S16 = Signed 16 bit components
+	F15 = Number of Fractional Bits per component
+*/
+
+TEST(ComplexFixedPoint, Layout)
+{
+	typedef ComplexFixedPoint<std::int16_t, 15> CS16F15;
+
+	/*
+	 * The interleaved layout has to match a plain array of I/Q pairs so that sample buffers can be used directly
+	 */
+	EXPECT_EQ(2 * sizeof(std::int16_t), sizeof(CS16F15));
+
+	std::int16_t iq[4] = { 100, -200, 300, -400 };
+	const CS16F15* samples = reinterpret_cast<const CS16F15*>(iq);
+
+	EXPECT_EQ(100, samples[0].real().raw());
+	EXPECT_EQ(-200, samples[0].imag().raw());
+	EXPECT_EQ(300, samples[1].real().raw());
+	EXPECT_EQ(-400, samples[1].imag().raw());
+}
+
+TEST(ComplexFixedPoint, AdditionSubtraction)
+{
+	typedef ComplexFixedPoint<std::int16_t, 8> CS16F8;
+
+	CS16F8 a(1.5, -2.25);
+	CS16F8 b(-0.5, 4.0);
+
+	EXPECT_EQ(CS16F8(1.0, 1.75), a + b);
+	EXPECT_EQ(CS16F8(2.0, -6.25), a - b);
+
+	a += b;
+	EXPECT_EQ(CS16F8(1.0, 1.75), a);
+
+	a -= b;
+	EXPECT_EQ(CS16F8(1.5, -2.25), a);
+
+	EXPECT_EQ(CS16F8(1.5, 2.25), a.conj());
+}
+
+TEST(ComplexFixedPoint, Multiplication)
+{
+	typedef ComplexFixedPoint<std::int16_t, 8> CS16F8;
+
+	/*
+	 * (1.5 - 2.25j)(-0.5 + 4j) = -0.75 + 6j + 1.125j + 9 = 8.25 + 7.125j
+	 */
+	CS16F8 a(1.5, -2.25);
+	CS16F8 b(-0.5, 4.0);
+	CS16F8 c(8.25, 7.125);
+
+	EXPECT_EQ(c, a * b);
+	EXPECT_EQ(c, a.gaussMultiply(b));
+
+	/*
+	 * (1.5 - 2.25j)(-0.5 - 4j) = -0.75 - 6j + 1.125j - 9 = -9.75 - 4.875j
+	 */
+	EXPECT_EQ(CS16F8(-9.75, -4.875), a.conjugateMultiply(b));
+	EXPECT_EQ(a * b.conj(), a.conjugateMultiply(b));
+
+	a *= b;
+	EXPECT_EQ(c, a);
+
+	/*
+	 * 1.5^2 + 2.25^2 = 7.3125
+	 */
+	CS16F8 d(1.5, -2.25);
+	EXPECT_EQ((FixedPoint<std::int16_t, 8>(7.3125)), d.magnitudeSquared());
+}
+
+TEST(ComplexFixedPoint, SingleRounding)
+{
+	typedef ComplexFixedPoint<std::int16_t, 15> CS16F15;
+
+	/*
+	 * Rescaling each component once must give the truncated exact result, which is not the case when four
+	 * separately rescaled operator* calls are combined
+	 */
+	CS16F15 a = CS16F15::createComplexFixedPoint(12345, -23456);
+	CS16F15 b = CS16F15::createComplexFixedPoint(-3210, 31000);
+
+	std::int64_t real = (std::int64_t(12345) * -3210 - std::int64_t(-23456) * 31000) >> 15;
+	std::int64_t imag = (std::int64_t(12345) * 31000 + std::int64_t(-23456) * -3210) >> 15;
+
+	CS16F15 c = a * b;
+	EXPECT_EQ(real, c.real().raw());
+	EXPECT_EQ(imag, c.imag().raw());
+	EXPECT_EQ(c, a.gaussMultiply(b));
+}
+
+TEST(ComplexFixedPoint, BatchKernels)
+{
+	typedef ComplexFixedPoint<std::int16_t, 12> CS16F12;
+
+	const std::size_t count = 37;
+	std::vector<CS16F12> a(count);
+	std::vector<CS16F12> b(count);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		a[i] = CS16F12::createComplexFixedPoint(std::int16_t(i * 97 - 1800), std::int16_t(1500 - i * 53));
+		b[i] = CS16F12::createComplexFixedPoint(std::int16_t(700 - i * 31), std::int16_t(i * 41 - 600));
+	}
+
+	std::vector<CS16F12> product(count);
+	std::vector<CS16F12> conjugate_product(count);
+	std::vector<FixedPoint<std::int16_t, 12>> magnitude(count);
+
+	complexMultiply(a.data(), b.data(), product.data(), count);
+	complexConjugateMultiply(a.data(), b.data(), conjugate_product.data(), count);
+	complexMagnitudeSquared(a.data(), magnitude.data(), count);
+
+	std::complex<double> expected_dot(0.0, 0.0);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		EXPECT_EQ(a[i] * b[i], product[i]);
+		EXPECT_EQ(a[i].conjugateMultiply(b[i]), conjugate_product[i]);
+		EXPECT_EQ(a[i].magnitudeSquared(), magnitude[i]);
+
+		std::complex<double> ad(a[i].real().toDouble(), a[i].imag().toDouble());
+		std::complex<double> bd(b[i].real().toDouble(), b[i].imag().toDouble());
+		expected_dot += ad * std::conj(bd);
+	}
+
+	/*
+	 * The accumulated dot product only loses precision at the single final rescale
+	 */
+	CS16F12 dot = complexConjugateDot(a.data(), b.data(), count);
+	EXPECT_NEAR(expected_dot.real(), dot.real().toDouble(), 1.0 / 4096);
+	EXPECT_NEAR(expected_dot.imag(), dot.imag().toDouble(), 1.0 / 4096);
+}
+
+TEST(ComplexFixedPoint, Extremes)
+{
+	typedef ComplexFixedPoint<std::int16_t, 15> CS16F15;
+	typedef ComplexFixedPoint<std::int32_t, 30> CS32F30;
+
+	/*
+	 * With every component lowest the sums of products exceed the wide type and wrap
+	 */
+	const std::int16_t LOWEST = std::numeric_limits<std::int16_t>::lowest();
+	CS16F15 a = CS16F15::createComplexFixedPoint(LOWEST, LOWEST);
+
+	std::int32_t twice = static_cast<std::int32_t>(static_cast<std::uint32_t>(2u << 30));
+	CS16F15 wrapped = CS16F15::createComplexFixedPoint(0, static_cast<std::int16_t>(twice >> 15));
+	EXPECT_EQ(wrapped, a * a);
+	EXPECT_EQ(CS16F15::createComplexFixedPoint(static_cast<std::int16_t>(twice >> 15), 0), a.conjugateMultiply(a));
+
+	const std::int32_t LOWEST32 = std::numeric_limits<std::int32_t>::lowest();
+	CS32F30 b = CS32F30::createComplexFixedPoint(LOWEST32, LOWEST32);
+	EXPECT_EQ(CS32F30::createComplexFixedPoint(0, static_cast<std::int32_t>(std::numeric_limits<std::int64_t>::lowest() >> 30)), b * b);
+
+	/*
+	 * The squared magnitude of the lowest values is exactly twice the largest square and only loses bits when narrowed
+	 */
+	EXPECT_EQ(static_cast<std::int16_t>((std::uint32_t(1) << 31) >> 15), a.magnitudeSquared().raw());
+	EXPECT_EQ(static_cast<std::int32_t>((std::uint64_t(1) << 63) >> 30), b.magnitudeSquared().raw());
+
+	typedef ComplexFixedPoint<std::int32_t, 16> CS32F16;
+	CS32F16 e = CS32F16::createComplexFixedPoint(LOWEST32, LOWEST32);
+	EXPECT_EQ(static_cast<std::int32_t>((std::uint64_t(1) << 63) >> 16), e.magnitudeSquared().raw());
+
+	CS32F16 f = CS32F16::createComplexFixedPoint(std::int32_t(-3) << 16, std::int32_t(-4) << 16);
+	EXPECT_EQ(25.0, f.magnitudeSquared().toDouble());
+
+	/*
+	 * 32 bit dot products accumulate beyond 64 bits
+	 */
+	std::vector<CS32F30> c(4, CS32F30::createComplexFixedPoint(LOWEST32, std::numeric_limits<std::int32_t>::max()));
+	std::vector<CS32F30> d(4, CS32F30::createComplexFixedPoint(LOWEST32, LOWEST32));
+
+	__int128 real = 0;
+	__int128 imag = 0;
+	for (std::size_t i = 0; i < c.size(); ++i)
+	{
+		__int128 ar = c[i].real().raw();
+		__int128 ai = c[i].imag().raw();
+		__int128 br = d[i].real().raw();
+		__int128 bi = d[i].imag().raw();
+		real += ar * br + ai * bi;
+		imag += ai * br - ar * bi;
+	}
+
+	CS32F30 dot = complexConjugateDot(c.data(), d.data(), c.size());
+	EXPECT_EQ(static_cast<std::int32_t>(real >> 30), dot.real().raw());
+	EXPECT_EQ(static_cast<std::int32_t>(imag >> 30), dot.imag().raw());
+}
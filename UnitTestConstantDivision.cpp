@@ -0,0 +1,140 @@
+/*!
+    \file UnitTestConstantDivision.cpp
+    \created 18/10/2026
+*/
+
+#include <ConstantDivision.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	/*!
+		\brief Compare against integer division for every raw value of a 16 bit format
+	*/
+	template <std::int64_t N, typename T>
+	void checkExhaustive()
+	{
+		typedef FixedPoint<T, 4> Fixed;
+
+		for (std::int64_t raw = std::numeric_limits<T>::min(); raw <= std::numeric_limits<T>::max(); ++raw)
+		{
+			Fixed x = Fixed::createFixedPoint(static_cast<T>(raw));
+			ASSERT_EQ(static_cast<T>(raw / N), divideBy<N>(x).raw()) << raw << " / " << N;
+		}
+	}
+
+	/*!
+		\brief Compare against integer division for random and extreme raw values of a 32 bit format
+	*/
+	template <std::int64_t N, typename T>
+	void checkRandom()
+	{
+		typedef FixedPoint<T, 16> Fixed;
+
+		std::mt19937 generator(static_cast<std::uint32_t>(N));
+		std::vector<std::int64_t> raws = { std::numeric_limits<T>::min(), std::numeric_limits<T>::min() + 1, -1, 0, 1,
+			std::numeric_limits<T>::max() - 1, std::numeric_limits<T>::max() };
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			raws.push_back(static_cast<T>(generator()));
+		}
+
+		for (std::int64_t raw : raws)
+		{
+			if (raw < std::numeric_limits<T>::min() || raw > std::numeric_limits<T>::max())
+			{
+				continue;
+			}
+
+			Fixed x = Fixed::createFixedPoint(static_cast<T>(raw));
+			ASSERT_EQ(static_cast<T>(raw / N), divideBy<N>(x).raw()) << raw << " / " << N;
+		}
+	}
+}
+
+TEST(ConstantDivision, Magic)
+{
+	/*
+	 * Division by 7 of 32 bit numerators uses the well known 33 bit multiplier 0x124924925
+	 */
+	EXPECT_EQ(3, (DivisionMagic<7, 32>::SHIFT));
+	EXPECT_EQ(0x24924925u, (DivisionMagic<7, 32>::MULTIPLIER));
+
+	/*
+	 * Powers of two reduce to a shift
+	 */
+	EXPECT_EQ(0u, (DivisionMagic<16, 32>::MULTIPLIER));
+	EXPECT_EQ(4, (DivisionMagic<16, 32>::SHIFT));
+	EXPECT_EQ(12345u, (DivisionMagic<1, 32>::divide(12345)));
+}
+
+TEST(ConstantDivision, Exhaustive16)
+{
+	checkExhaustive<3, std::int16_t>();
+	checkExhaustive<7, std::int16_t>();
+	checkExhaustive<10, std::int16_t>();
+	checkExhaustive<-5, std::int16_t>();
+	checkExhaustive<1, std::int16_t>();
+	checkExhaustive<-1, std::int16_t>();
+	checkExhaustive<32768, std::int16_t>();
+	checkExhaustive<641, std::int16_t>();
+
+	checkExhaustive<3, std::uint16_t>();
+	checkExhaustive<7, std::uint16_t>();
+	checkExhaustive<64, std::uint16_t>();
+	checkExhaustive<65535, std::uint16_t>();
+}
+
+TEST(ConstantDivision, Random32)
+{
+	checkRandom<3, std::int32_t>();
+	checkRandom<7, std::int32_t>();
+	checkRandom<1000, std::int32_t>();
+	checkRandom<-86400, std::int32_t>();
+	checkRandom<2147483647, std::int32_t>();
+
+	checkRandom<3, std::uint32_t>();
+	checkRandom<7, std::uint32_t>();
+	checkRandom<641, std::uint32_t>();
+	checkRandom<4294967295, std::uint32_t>();
+}
+
+TEST(ConstantDivision, FixedDivisor)
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+
+	/*
+	 * Dividing by 0.25 multiplies by four and dividing by 2.5 matches the shifted integer division
+	 */
+	EXPECT_EQ(6.0, (divideByFixed<fixedPointRaw<std::int32_t, 16>(0.25), 16>(S32F16(1.5)).toDouble()));
+	EXPECT_EQ(-3.0, (divideByFixed<fixedPointRaw<std::int16_t, 8>(2.5), 8>(S32F16(-7.5)).toDouble()));
+
+	std::mt19937 generator(42);
+	for (int i = 0; i < 100000; ++i)
+	{
+		S32F16 x = S32F16::createFixedPoint(static_cast<std::int32_t>(generator()) >> 4);
+
+		std::int64_t expected = (static_cast<std::int64_t>(x.raw()) << 12) / 7000;
+		ASSERT_EQ(static_cast<std::int32_t>(expected), (divideByFixed<7000, 12>(x).raw())) << x.raw();
+	}
+
+	/*
+	 * Batch forms
+	 */
+	std::vector<S32F16> in = { S32F16(10.0), S32F16(-10.0), S32F16(0.5) };
+	std::vector<S32F16> out(3);
+	divideBy<4>(in.data(), out.data(), in.size());
+	EXPECT_EQ(2.5, out[0].toDouble());
+	EXPECT_EQ(-2.5, out[1].toDouble());
+	EXPECT_EQ(0.125, out[2].toDouble());
+
+	divideByFixed<fixedPointRaw<std::int32_t, 4>(0.5), 4>(in.data(), out.data(), in.size());
+	EXPECT_EQ(20.0, out[0].toDouble());
+	EXPECT_EQ(-20.0, out[1].toDouble());
+	EXPECT_EQ(1.0, out[2].toDouble());
+}
@@ -0,0 +1,116 @@
+/*!
+    \file UnitTestDynamicRangeProfiler.cpp
+    \created 18/10/2026
+*/
+
+#include <DynamicRangeProfiler.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+TEST(DynamicRangeProfiler, Recording)
+{
+	DynamicRangeProfiler::reset();
+
+	typedef ProfiledFixedPoint<std::int32_t, 12> P32F12;
+
+	P32F12 gain("gain", 1.5);
+	P32F12 sample("sample");
+
+	for (int i = -4; i <= 4; ++i)
+	{
+		sample = P32F12(0.3 * i) * gain;
+	}
+
+	std::vector<DynamicRangeProfiler::VariableProfile> profiles = DynamicRangeProfiler::profiles();
+	ASSERT_EQ(2u, profiles.size());
+
+	const DynamicRangeProfiler::VariableProfile& gain_profile = profiles[0];
+	EXPECT_EQ("gain", gain_profile.name);
+	EXPECT_EQ(1u, gain_profile.count);
+	EXPECT_EQ(0.0, gain_profile.maxError);
+
+	const DynamicRangeProfiler::VariableProfile& sample_profile = profiles[1];
+	EXPECT_EQ("sample", sample_profile.name);
+	EXPECT_EQ(9u, sample_profile.count);
+	EXPECT_EQ(1u, sample_profile.zeros);
+	EXPECT_DOUBLE_EQ(-1.8, sample_profile.min);
+	EXPECT_DOUBLE_EQ(1.8, sample_profile.max);
+	EXPECT_EQ(32, sample_profile.recordedBits);
+	EXPECT_EQ(12, sample_profile.recordedFraction);
+
+	/*
+	 * 0.3 is not representable so the error against the ideal is non zero but within a few steps of F12
+	 */
+	EXPECT_GT(sample_profile.maxError, 0.0);
+	EXPECT_LT(sample_profile.maxError, 4.0 / 4096);
+
+	/*
+	 * Magnitudes 0.45 and 0.9 fall within [2^-2, 2^0) and 1.35, 1.8 within [2^0, 2^1)
+	 */
+	EXPECT_EQ(4u, sample_profile.histogram[64 - 2] + sample_profile.histogram[64 - 1]);
+	EXPECT_EQ(4u, sample_profile.histogram[64]);
+}
+
+TEST(DynamicRangeProfiler, Recommendation)
+{
+	DynamicRangeProfiler::reset();
+
+	typedef ProfiledFixedPoint<std::int32_t, 20> P32F20;
+	typedef ProfiledFixedPoint<std::uint32_t, 16> U32F16;
+
+	P32F20 small("small");
+	U32F16 large("large");
+
+	small = P32F20(-0.75);
+	small = P32F20(0.5);
+	large = U32F16(200.0);
+	large = U32F16(3.0);
+
+	/*
+	 * With a budget of 2^-6 and one bit of headroom, small needs a sign, one integer bit and six fractional bits
+	 * which fits 8 bits, and large needs nine integer bits and six fractional bits which fits unsigned 16 bits
+	 */
+	std::vector<DynamicRangeProfiler::Recommendation> recommendations = DynamicRangeProfiler::recommend(1.0 / 64);
+	ASSERT_EQ(2u, recommendations.size());
+
+	EXPECT_EQ("large", recommendations[0].name);
+	EXPECT_TRUE(recommendations[0].fits);
+	EXPECT_FALSE(recommendations[0].isSigned);
+	EXPECT_EQ(9, recommendations[0].integerBits);
+	EXPECT_EQ(6, recommendations[0].minimumFraction);
+	EXPECT_EQ("FixedPoint<std::uint16_t, 7>", recommendations[0].type);
+
+	EXPECT_EQ("small", recommendations[1].name);
+	EXPECT_TRUE(recommendations[1].fits);
+	EXPECT_TRUE(recommendations[1].isSigned);
+	EXPECT_EQ(1, recommendations[1].integerBits);
+	EXPECT_EQ("FixedPoint<std::int8_t, 6>", recommendations[1].type);
+
+	/*
+	 * A budget too tight for 32 bits is reported as not fitting
+	 */
+	recommendations = DynamicRangeProfiler::recommend(std::ldexp(1.0, -30));
+	EXPECT_FALSE(recommendations[0].fits);
+
+	std::ostringstream stream;
+	DynamicRangeProfiler::dump(stream, 1.0 / 64);
+	EXPECT_NE(std::string::npos, stream.str().find("recommended: FixedPoint<std::int8_t, 6>"));
+
+	/*
+	 * Unsigned data below one without headroom is limited to the 31 fractional bits FixedPoint accepts
+	 */
+	DynamicRangeProfiler::reset();
+
+	U32F16 unit("unit");
+	unit = U32F16(0.75);
+
+	recommendations = DynamicRangeProfiler::recommend(std::ldexp(1.0, -20), 0);
+	ASSERT_EQ(1u, recommendations.size());
+	EXPECT_TRUE(recommendations[0].fits);
+	EXPECT_EQ(0, recommendations[0].integerBits);
+	EXPECT_EQ(32, recommendations[0].storageBits);
+	EXPECT_EQ(31, recommendations[0].fraction);
+	EXPECT_EQ("FixedPoint<std::uint32_t, 31>", recommendations[0].type);
+}
@@ -34,6 +34,9 @@ TEST(FixedPoint, NumericLimitsGeneral)
 	//EXPECT_EQ(U8F4(0), std::numeric_limits<U8F4>::digits);
 	//EXPECT_EQ(U8F4(0), std::numeric_limits<U8F4>::digits10);
 	EXPECT_FALSE(std::numeric_limits<U8F4>::is_signed);
+	EXPECT_EQ(8, std::numeric_limits<U8F4>::digits);
+	EXPECT_TRUE((std::numeric_limits<FixedPoint<std::int16_t, 4>>::is_signed));
+	EXPECT_EQ(15, (std::numeric_limits<FixedPoint<std::int16_t, 4>>::digits));
 	EXPECT_FALSE(std::numeric_limits<U8F4>::is_integer);
 	EXPECT_FALSE(std::numeric_limits<U8F4>::is_exact);
 
@@ -539,4 +542,74 @@ TEST(FixedPoint, NonExactInitialisation)
 
 	FixedPoint<std::uint16_t, 14> u16f14_b(1.23456);
 	EXPECT_EQ(u16f14_a, u16f14_b);
-}
\ No newline at end of file
+}
+
+TEST(FixedPoint, ExactArithmetic)
+{
+	/*
+	 * S8F5 is Q3.5 and S8F6 is Q2.6. The exact product is Q5.11 held in 16 bits and the exact sum is Q4.6
+	 */
+	std::cout << "[          ] S8F5 * S8F6 Multiplication Exact - Q3.5 * Q2.6 = Q5.11" << std::endl;
+	FixedPoint<std::int8_t, 5> s8f5_a(-3.96875);
+	FixedPoint<std::int8_t, 6> s8f6_a(1.984375);
+	auto s16f11_a = mulExact(s8f5_a, s8f6_a);
+
+	std::cout << "[          ] A:          " << s8f5_a.rawBitSet() << " " << s8f5_a.toDouble() << std::endl;
+	std::cout << "[          ] B:          " << s8f6_a.rawBitSet() << "  " << s8f6_a.toDouble() << std::endl;
+	std::cout << "[          ] C:  " << s16f11_a.rawBitSet() << " " << s16f11_a.toDouble() << std::endl;
+	std::cout << "[          ]" << std::endl;
+
+	EXPECT_TRUE((std::is_same<decltype(s16f11_a), FixedPoint<std::int16_t, 11>>::value));
+	EXPECT_EQ(-3.96875 * 1.984375, s16f11_a.toDouble());
+
+	std::cout << "[          ] S8F5 + S8F6 Addition Exact - Q3.5 + Q2.6 = Q4.6" << std::endl;
+	auto s16f6_a = addExact(s8f5_a, s8f6_a);
+	auto s16f6_b = subExact(s8f5_a, s8f6_a);
+
+	EXPECT_TRUE((std::is_same<decltype(s16f6_a), FixedPoint<std::int16_t, 6>>::value));
+	EXPECT_EQ(-3.96875 + 1.984375, s16f6_a.toDouble());
+	EXPECT_EQ(-3.96875 - 1.984375, s16f6_b.toDouble());
+
+	/*
+	 * Storage only grows when the bits do not fit, and unsigned operands stay unsigned
+	 */
+	FixedPoint<std::uint8_t, 4> u8f4_a(15.9375);
+	FixedPoint<std::uint8_t, 4> u8f4_b(15.9375);
+	auto u16f4_a = addExact(u8f4_a, u8f4_b);
+	EXPECT_TRUE((std::is_same<decltype(u16f4_a), FixedPoint<std::uint16_t, 4>>::value));
+	EXPECT_EQ(31.875, u16f4_a.toDouble());
+
+	/*
+	 * Differences of unsigned operands gain a sign bit, so negative results are kept
+	 */
+	auto s16f4_a = subExact(FixedPoint<std::uint8_t, 4>(1.0), FixedPoint<std::uint8_t, 4>(2.0));
+	EXPECT_TRUE((std::is_same<decltype(s16f4_a), FixedPoint<std::int16_t, 4>>::value));
+	EXPECT_EQ(-1.0, s16f4_a.toDouble());
+
+	auto s16f4_b = subExact(FixedPoint<std::uint8_t, 4>(0.0), u8f4_a);
+	EXPECT_EQ(-15.9375, s16f4_b.toDouble());
+
+	auto s32f16_b = subExact(FixedPoint<std::uint16_t, 16>::createFixedPoint(0), FixedPoint<std::uint16_t, 8>::createFixedPoint(65535));
+	EXPECT_TRUE((std::is_same<decltype(s32f16_b), FixedPoint<std::int32_t, 16>>::value));
+	EXPECT_EQ(-255.99609375, s32f16_b.toDouble());
+
+	FixedPoint<std::int16_t, 15> s16f15_a = FixedPoint<std::int16_t, 15>::createFixedPoint(std::int16_t(-32768));
+	FixedPoint<std::int16_t, 15> s16f15_b = FixedPoint<std::int16_t, 15>::createFixedPoint(std::int16_t(-32768));
+	auto s32f30_a = mulExact(s16f15_a, s16f15_b);
+	EXPECT_TRUE((std::is_same<decltype(s32f30_a), FixedPoint<std::int32_t, 30>>::value));
+	EXPECT_EQ(1.0, s32f30_a.toDouble());
+
+	FixedPoint<std::int32_t, 16> s32f16_a(-1234.5);
+	FixedPoint<std::uint16_t, 8> u16f8_a(100.25);
+	auto s64f24_a = mulExact(s32f16_a, u16f8_a);
+	EXPECT_TRUE((std::is_same<decltype(s64f24_a), FixedPoint<std::int64_t, 24>>::value));
+	EXPECT_EQ(-1234.5 * 100.25, s64f24_a.toDouble());
+
+	/*
+	 * The caller picks where the one quantisation step happens
+	 */
+	FixedPoint<std::int8_t, 5> s8f5_b(3.96875);
+	FixedPoint<std::int16_t, 8> s16f8_a = mulExact(s8f5_b, s8f6_a).convert<std::int16_t, 8>();
+	FixedPoint<std::int16_t, 8> s16f8_b(3.96875 * 1.984375);
+	EXPECT_EQ(s16f8_a, s16f8_b);
+}
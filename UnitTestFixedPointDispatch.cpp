@@ -0,0 +1,170 @@
+/*!
+    \file UnitTestFixedPointDispatch.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointDispatch.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(FixedPointDispatch, Selection)
+{
+	IsaLevel level = IsaLevel::BASELINE;
+	EXPECT_TRUE(parseIsaLevel("avx2", level));
+	EXPECT_EQ(IsaLevel::AVX2, level);
+	EXPECT_FALSE(parseIsaLevel("neon", level));
+	EXPECT_EQ(IsaLevel::AVX2, level);
+
+	/*
+	 * An override may lower the detected level but never raise it
+	 */
+	EXPECT_EQ(IsaLevel::AVX2, selectIsaLevel(nullptr, IsaLevel::AVX2));
+	EXPECT_EQ(IsaLevel::SSE42, selectIsaLevel("sse4.2", IsaLevel::AVX2));
+	EXPECT_EQ(IsaLevel::BASELINE, selectIsaLevel("baseline", IsaLevel::AVX512));
+	EXPECT_EQ(IsaLevel::SSE42, selectIsaLevel("avx512", IsaLevel::SSE42));
+	EXPECT_EQ(IsaLevel::AVX2, selectIsaLevel("unknown", IsaLevel::AVX2));
+
+	EXPECT_LE(activeIsaLevel(), detectIsaLevel());
+	EXPECT_EQ(activeIsaLevel(), (FixedPointKernels<std::int32_t, 16>::get().level));
+}
+
+TEST(FixedPointDispatch, Kernels)
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+	typedef FixedPointKernels<std::int32_t, 16> Kernels;
+
+	const std::size_t count = 1003;
+	std::vector<S32F16> lhs(count);
+	std::vector<S32F16> rhs(count);
+	std::vector<double> doubles(count);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		lhs[i] = S32F16::createFixedPoint(static_cast<std::int32_t>(i * 2654435761u) >> 8);
+		rhs[i] = S32F16::createFixedPoint(static_cast<std::int32_t>(i * 40503u) - 20000000);
+		doubles[i] = 0.37 * static_cast<double>(i) - 150.0;
+	}
+
+	const S32F16 taps[3] = { S32F16(0.5), S32F16(-0.25), S32F16(0.125) };
+
+	EXPECT_EQ(0, Kernels::forLevel(IsaLevel::BASELINE).dot(taps, taps, 0).raw());
+
+	/*
+	 * Scalar reference
+	 */
+	std::vector<S32F16> expected_add(count);
+	std::vector<S32F16> expected_multiply(count);
+	std::vector<S32F16> expected_quantise(count);
+	std::vector<S32F16> expected_filter(count - 2);
+	std::int64_t expected_dot = 0;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::int64_t product = static_cast<std::int64_t>(lhs[i].raw()) * rhs[i].raw();
+		expected_add[i] = S32F16::createFixedPoint(lhs[i].raw() + rhs[i].raw());
+		expected_multiply[i] = S32F16::createFixedPoint(static_cast<std::int32_t>(product >> 16));
+		expected_quantise[i] = S32F16(doubles[i]);
+		expected_dot += product;
+	}
+
+	for (std::size_t i = 0; i + 2 < count; ++i)
+	{
+		std::int64_t sum = 0;
+		for (std::size_t k = 0; k < 3; ++k)
+		{
+			sum += static_cast<std::int64_t>(taps[k].raw()) * lhs[i + 2 - k].raw();
+		}
+		expected_filter[i] = S32F16::createFixedPoint(static_cast<std::int32_t>(sum >> 16));
+	}
+
+	/*
+	 * Every level supported by this processor gives bit identical results
+	 */
+	for (IsaLevel level : { IsaLevel::BASELINE, IsaLevel::SSE42, IsaLevel::AVX2, IsaLevel::AVX512 })
+	{
+		if (level > detectIsaLevel())
+		{
+			continue;
+		}
+
+		Kernels kernels = Kernels::forLevel(level);
+		std::vector<S32F16> out(count);
+
+		kernels.add(lhs.data(), rhs.data(), out.data(), count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ(expected_add[i].raw(), out[i].raw()) << isaLevelName(level) << " add " << i;
+		}
+
+		kernels.multiply(lhs.data(), rhs.data(), out.data(), count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ(expected_multiply[i].raw(), out[i].raw()) << isaLevelName(level) << " multiply " << i;
+		}
+
+		kernels.quantise(doubles.data(), out.data(), count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ(expected_quantise[i].raw(), out[i].raw()) << isaLevelName(level) << " quantise " << i;
+		}
+
+		kernels.filter(lhs.data(), count, taps, 3, out.data());
+		for (std::size_t i = 0; i + 2 < count; ++i)
+		{
+			ASSERT_EQ(expected_filter[i].raw(), out[i].raw()) << isaLevelName(level) << " filter " << i;
+		}
+
+		EXPECT_EQ(static_cast<std::int32_t>(expected_dot >> 16), kernels.dot(lhs.data(), rhs.data(), count).raw()) << isaLevelName(level);
+	}
+}
+
+TEST(FixedPointDispatch, Extremes)
+{
+	/*
+	 * Full scale 32 bit sums of products exceed 64 bits
+	 */
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+	typedef FixedPointKernels<std::int32_t, 16> Kernels;
+
+	const std::int32_t LOWEST = std::numeric_limits<std::int32_t>::lowest();
+	std::vector<S32F16> lowest(8, S32F16::createFixedPoint(LOWEST));
+	std::vector<S32F16> out(8);
+
+	__int128 square = static_cast<__int128>(LOWEST) * LOWEST;
+	std::int32_t expected_dot = static_cast<std::int32_t>((8 * square) >> 16);
+	std::int32_t expected_filter = static_cast<std::int32_t>((3 * square) >> 16);
+
+	for (IsaLevel level : { IsaLevel::BASELINE, IsaLevel::SSE42, IsaLevel::AVX2, IsaLevel::AVX512 })
+	{
+		if (level > detectIsaLevel())
+		{
+			continue;
+		}
+
+		Kernels kernels = Kernels::forLevel(level);
+		EXPECT_EQ(expected_dot, kernels.dot(lowest.data(), lowest.data(), 8).raw()) << isaLevelName(level);
+
+		kernels.filter(lowest.data(), 8, lowest.data(), 3, out.data());
+		for (std::size_t i = 0; i < 6; ++i)
+		{
+			ASSERT_EQ(expected_filter, out[i].raw()) << isaLevelName(level) << " filter " << i;
+		}
+	}
+
+	/*
+	 * Unsigned 32 bit products are formed in 64 unsigned bits
+	 */
+	typedef FixedPoint<std::uint32_t, 16> U32F16;
+	const std::uint32_t MAX = std::numeric_limits<std::uint32_t>::max();
+	std::vector<U32F16> largest(4, U32F16::createFixedPoint(MAX));
+	std::vector<U32F16> products(4);
+
+	FixedPointKernels<std::uint32_t, 16> unsigned_kernels = FixedPointKernels<std::uint32_t, 16>::forLevel(IsaLevel::BASELINE);
+	unsigned_kernels.multiply(largest.data(), largest.data(), products.data(), 4);
+	EXPECT_EQ(static_cast<std::uint32_t>((std::uint64_t(MAX) * MAX) >> 16), products[0].raw());
+
+	unsigned __int128 sum = static_cast<unsigned __int128>(std::uint64_t(MAX) * MAX) * 4;
+	EXPECT_EQ(static_cast<std::uint32_t>(sum >> 16), unsigned_kernels.dot(largest.data(), largest.data(), 4).raw());
+}
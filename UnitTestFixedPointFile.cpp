@@ -0,0 +1,154 @@
+/*!
+    \file UnitTestFixedPointFile.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointFile.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+	std::string temporaryPath(const std::string& name)
+	{
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+}
+
+TEST(FixedPointFile, RoundTrip)
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+
+	const std::string path = temporaryPath("UnitTestFixedPointFile_RoundTrip.fxp");
+
+	std::vector<S32F16> first;
+	std::vector<S32F16> second;
+	for (int i = 0; i < 1000; ++i)
+	{
+		first.push_back(S32F16::createFixedPoint(i * 7919 - 3000000));
+	}
+	for (int i = 0; i < 13; ++i)
+	{
+		second.push_back(S32F16(-0.5 * i));
+	}
+
+	{
+		FixedPointFileWriter<std::int32_t, 16> writer(path);
+		writer.append(first.data(), first.size());
+		writer.append(second.data(), second.size());
+		writer.append(nullptr, 0);
+	}
+
+	FixedPointFileReader reader(path);
+	EXPECT_EQ(3u, reader.chunks());
+	EXPECT_EQ(1013u, reader.size());
+	EXPECT_EQ(16, reader.header().fraction);
+	EXPECT_EQ(31, reader.header().digits);
+	EXPECT_EQ(1, reader.header().isSigned);
+
+	std::span<const S32F16> values = reader.chunk<std::int32_t, 16>(0);
+	ASSERT_EQ(first.size(), values.size());
+	for (std::size_t i = 0; i < first.size(); ++i)
+	{
+		EXPECT_EQ(first[i].raw(), values[i].raw());
+	}
+
+	/*
+	 * Every chunk starts on an aligned boundary of the mapping
+	 */
+	values = reader.chunk<std::int32_t, 16>(1);
+	ASSERT_EQ(second.size(), values.size());
+	EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.data()) % FixedPointFileHeader::ALIGNMENT);
+	EXPECT_EQ(-6.0, values[12].toDouble());
+
+	EXPECT_TRUE((reader.chunk<std::int32_t, 16>(2).empty()));
+	EXPECT_THROW((reader.chunk<std::int32_t, 16>(3)), std::out_of_range);
+
+	std::remove(path.c_str());
+}
+
+TEST(FixedPointFile, TypeMismatch)
+{
+	const std::string path = temporaryPath("UnitTestFixedPointFile_TypeMismatch.fxp");
+
+	std::vector<FixedPoint<std::uint16_t, 8>> values(10, FixedPoint<std::uint16_t, 8>(1.5));
+
+	{
+		FixedPointFileWriter<std::uint16_t, 8> writer(path);
+		writer.append(values.data(), values.size());
+	}
+
+	FixedPointFileReader reader(path);
+	EXPECT_TRUE((reader.matches<std::uint16_t, 8>()));
+	EXPECT_FALSE((reader.matches<std::int16_t, 8>()));
+	EXPECT_FALSE((reader.matches<std::uint16_t, 7>()));
+	EXPECT_FALSE((reader.matches<std::uint32_t, 8>()));
+
+	EXPECT_THROW((reader.chunk<std::int16_t, 8>(0)), std::runtime_error);
+	EXPECT_THROW((reader.chunk<std::uint32_t, 8>(0)), std::runtime_error);
+	EXPECT_EQ(1.5, (reader.chunk<std::uint16_t, 8>(0)[9].toDouble()));
+
+	std::remove(path.c_str());
+}
+
+TEST(FixedPointFile, InvalidFiles)
+{
+	const std::string path = temporaryPath("UnitTestFixedPointFile_InvalidFiles.fxp");
+
+	EXPECT_THROW(FixedPointFileReader(temporaryPath("UnitTestFixedPointFile_Missing.fxp")), std::runtime_error);
+
+	{
+		std::ofstream stream(path, std::ios::binary);
+		stream << "not a fixed point file";
+	}
+	EXPECT_THROW(FixedPointFileReader reader(path), std::runtime_error);
+
+	/*
+	 * A writer that has not been closed leaves a header without an index
+	 */
+	{
+		FixedPointFileWriter<std::int8_t, 4> writer(path);
+		FixedPoint<std::int8_t, 4> value(1.0);
+		writer.append(&value, 1);
+
+		EXPECT_THROW(FixedPointFileReader reader(path), std::runtime_error);
+	}
+
+	FixedPointFileReader reader(path);
+	EXPECT_EQ(1u, reader.size());
+
+	std::remove(path.c_str());
+
+	/*
+	 * Headers with element sizes, alignments or payloads that would corrupt the chunk checks are rejected
+	 */
+	auto corrupt = [&](std::size_t offset, auto value)
+	{
+		{
+			FixedPointFileWriter<std::int16_t, 8> writer(path);
+			FixedPoint<std::int16_t, 8> values[3] = { FixedPoint<std::int16_t, 8>(1.0), FixedPoint<std::int16_t, 8>(2.0), FixedPoint<std::int16_t, 8>(3.0) };
+			writer.append(values, 3);
+		}
+
+		{
+			std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+			stream.seekp(static_cast<std::streamoff>(offset));
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		EXPECT_THROW(FixedPointFileReader reader(path), std::runtime_error) << offset;
+		std::remove(path.c_str());
+	};
+
+	corrupt(offsetof(FixedPointFileHeader, elementSize), std::uint32_t(0));
+	corrupt(offsetof(FixedPointFileHeader, elementSize), std::uint32_t(3));
+	corrupt(offsetof(FixedPointFileHeader, alignment), std::uint32_t(0));
+	corrupt(offsetof(FixedPointFileHeader, alignment), std::uint32_t(63));
+	corrupt(offsetof(FixedPointFileHeader, indexOffset), std::uint64_t(32));
+}
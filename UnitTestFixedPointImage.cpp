@@ -0,0 +1,278 @@
+/*!
+    \file UnitTestFixedPointImage.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointImage.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	typedef FixedPoint<std::uint16_t, 8> U16F8;
+	typedef FixedPointImage<std::uint16_t, 8> Frame;
+
+	Frame randomFrame(std::size_t width, std::size_t height, std::uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		Frame frame(width, height);
+		for (std::size_t y = 0; y < height; ++y)
+		{
+			for (std::size_t x = 0; x < width; ++x)
+			{
+				frame(x, y) = U16F8::createFixedPoint(static_cast<std::uint16_t>(generator()));
+			}
+		}
+
+		return frame;
+	}
+
+	/*!
+		\brief Direct convolution with replicated edges, rounding to nearest and saturation
+	*/
+	template <typename U, std::int8_t H, int KW, int KH>
+	FixedPointImage<U, H> reference(const Frame& in, const std::array<std::int32_t, KW * KH>& coefficients, int shift)
+	{
+		FixedPointImage<U, H> out(in.width(), in.height());
+		const int LAST_X = static_cast<int>(in.width()) - 1;
+		const int LAST_Y = static_cast<int>(in.height()) - 1;
+
+		for (int y = 0; y <= LAST_Y; ++y)
+		{
+			for (int x = 0; x <= LAST_X; ++x)
+			{
+				std::int64_t sum = 0;
+				for (int ky = 0; ky < KH; ++ky)
+				{
+					for (int kx = 0; kx < KW; ++kx)
+					{
+						int sx = std::clamp(x + kx - KW / 2, 0, LAST_X);
+						int sy = std::clamp(y + ky - KH / 2, 0, LAST_Y);
+						sum += static_cast<std::int64_t>(in(sx, sy).raw()) * coefficients[ky * KW + kx];
+					}
+				}
+
+				std::int64_t value = shift > 0 ? (sum + (std::int64_t(1) << (shift - 1))) >> shift : sum << -shift;
+				value = std::clamp<std::int64_t>(value, std::numeric_limits<U>::min(), std::numeric_limits<U>::max());
+				out(x, y) = FixedPoint<U, H>::createFixedPoint(static_cast<U>(value));
+			}
+		}
+
+		return out;
+	}
+
+	template <typename U, std::int8_t H>
+	void expectEqual(const FixedPointImage<U, H>& expected, const FixedPointImage<U, H>& actual)
+	{
+		ASSERT_EQ(expected.width(), actual.width());
+		ASSERT_EQ(expected.height(), actual.height());
+
+		for (std::size_t y = 0; y < expected.height(); ++y)
+		{
+			for (std::size_t x = 0; x < expected.width(); ++x)
+			{
+				ASSERT_EQ(expected(x, y).raw(), actual(x, y).raw()) << x << ", " << y;
+			}
+		}
+	}
+}
+
+TEST(FixedPointImage, Image)
+{
+	Frame frame(4, 3);
+	EXPECT_EQ(4u, frame.width());
+	EXPECT_EQ(3u, frame.height());
+
+	frame(1, 2) = U16F8(5.5);
+	EXPECT_EQ(5.5, frame.row(2)[1].toDouble());
+	EXPECT_EQ(5.5, frame.data()[9].toDouble());
+}
+
+TEST(FixedPointImage, Convolve)
+{
+	/*
+	 * Sizes that are not multiples of the tile, to exercise partial tiles and every border
+	 */
+	Frame frame = randomFrame(301, 77, 1);
+
+	/*
+	 * The identity kernel converts between formats
+	 */
+	ConvolutionKernel<3, 3, 4> identity{ { 0, 0, 0, 0, 16, 0, 0, 0, 0 } };
+	FixedPointImage<std::int32_t, 10> wide;
+	convolve(frame, wide, identity);
+
+	for (std::size_t y = 0; y < frame.height(); ++y)
+	{
+		for (std::size_t x = 0; x < frame.width(); ++x)
+		{
+			ASSERT_EQ(frame(x, y).raw() * 4, wide(x, y).raw());
+		}
+	}
+
+	/*
+	 * A general kernel matches the direct sum, for any number of threads
+	 */
+	ConvolutionKernel<5, 3, 6> kernel{ { 1, -2, 3, -4, 5, 6, 7, 8, 9, 10, -11, 12, -13, 14, 15 } };
+	FixedPointImage<std::int16_t, 4> expected = reference<std::int16_t, 4, 5, 3>(frame, kernel.coefficients, 8 + 6 - 4);
+
+	for (std::size_t threads : { 1u, 3u, 16u })
+	{
+		FixedPointImage<std::int16_t, 4> out;
+		convolve(frame, out, kernel, threads);
+		expectEqual(expected, out);
+	}
+}
+
+TEST(FixedPointImage, Separable)
+{
+	Frame frame = randomFrame(200, 100, 2);
+
+	/*
+	 * Equal to the full kernel of the outer product, including when rounding shifts left
+	 */
+	SeparableKernel<3, 5, 3, std::int32_t> separable{ { 1, 6, 1 }, { -1, 2, 4, 2, -1 } };
+
+	std::array<std::int32_t, 15> full;
+	for (int ky = 0; ky < 5; ++ky)
+	{
+		for (int kx = 0; kx < 3; ++kx)
+		{
+			full[ky * 3 + kx] = separable.vertical[ky] * separable.horizontal[kx];
+		}
+	}
+
+	FixedPointImage<std::uint16_t, 8> blurred;
+	convolve(frame, blurred, separable, 4);
+	expectEqual(reference<std::uint16_t, 8, 3, 5>(frame, full, 6), blurred);
+
+	FixedPointImage<std::int32_t, 16> precise;
+	convolve(frame, precise, separable);
+	expectEqual(reference<std::int32_t, 16, 3, 5>(frame, full, -2), precise);
+}
+
+TEST(FixedPointImage, Sobel)
+{
+	/*
+	 * A ramp rising by 0.5 per column has a gradient of 8 * 0.5 inside and half that at the edges
+	 */
+	Frame ramp(20, 10);
+	for (std::size_t y = 0; y < ramp.height(); ++y)
+	{
+		for (std::size_t x = 0; x < ramp.width(); ++x)
+		{
+			ramp(x, y) = U16F8(0.5 * static_cast<double>(x));
+		}
+	}
+
+	FixedPointImage<std::int32_t, 8> gx;
+	FixedPointImage<std::int32_t, 8> gy;
+	sobelX(ramp, gx);
+	sobelY(ramp, gy, 2);
+
+	for (std::size_t y = 0; y < ramp.height(); ++y)
+	{
+		EXPECT_EQ(2.0, gx(0, y).toDouble());
+		EXPECT_EQ(2.0, gx(19, y).toDouble());
+		for (std::size_t x = 1; x + 1 < ramp.width(); ++x)
+		{
+			EXPECT_EQ(4.0, gx(x, y).toDouble());
+			EXPECT_EQ(0.0, gy(x, y).toDouble());
+		}
+	}
+
+	/*
+	 * Outputs as wide as the 32 bit accumulator or wider saturate against their own limits
+	 */
+	FixedPointImage<std::int64_t, 8> gx64;
+	FixedPointImage<std::uint32_t, 8> gx32;
+	FixedPointImage<std::uint32_t, 8> gxNegative;
+	sobelX(ramp, gx64);
+	sobelX(ramp, gx32);
+	convolve(ramp, gxNegative, SeparableKernel<3, 3, 0, std::int32_t>{ { 1, 0, -1 }, { 1, 2, 1 } });
+
+	for (std::size_t y = 0; y < ramp.height(); ++y)
+	{
+		for (std::size_t x = 0; x < ramp.width(); ++x)
+		{
+			EXPECT_EQ(gx(x, y).raw(), gx64(x, y).raw());
+			EXPECT_EQ(static_cast<std::uint32_t>(gx(x, y).raw()), gx32(x, y).raw());
+			EXPECT_EQ(0u, gxNegative(x, y).raw());
+		}
+	}
+}
+
+TEST(FixedPointImage, Gaussian)
+{
+	/*
+	 * Coefficients are symmetric and sum to exactly one
+	 */
+	SeparableKernel<7, 7, 7, std::int32_t> kernel = gaussianKernel<7, 7, std::int32_t>(1.5);
+	std::int32_t sum = 0;
+	for (int k = 0; k < 7; ++k)
+	{
+		EXPECT_EQ(kernel.horizontal[k], kernel.horizontal[6 - k]);
+		EXPECT_EQ(kernel.horizontal[k], kernel.vertical[k]);
+		sum += kernel.horizontal[k];
+	}
+
+	EXPECT_EQ(128, sum);
+	EXPECT_GT(kernel.horizontal[3], kernel.horizontal[2]);
+
+	/*
+	 * Flat frames pass through unchanged, even at the largest pixel
+	 */
+	Frame flat(50, 40);
+	std::fill(flat.data(), flat.data() + 50 * 40, U16F8::createFixedPoint(65535));
+
+	Frame blurred;
+	gaussianBlur<7>(flat, blurred, 1.5, 3);
+	for (std::size_t i = 0; i < 50 * 40; ++i)
+	{
+		ASSERT_EQ(65535, blurred.data()[i].raw());
+	}
+
+	/*
+	 * A single bright pixel spreads into the kernel
+	 */
+	Frame point(9, 9);
+	point(4, 4) = U16F8(128.0);
+	gaussianBlur<7>(point, blurred, 1.5);
+	EXPECT_EQ(128.0 * kernel.horizontal[3] * kernel.horizontal[3] / 16384, blurred(4, 4).toDouble());
+	EXPECT_EQ(128.0 * kernel.horizontal[1] * kernel.horizontal[4] / 16384, blurred(2, 5).toDouble());
+	EXPECT_EQ(0.0, blurred(0, 4).toDouble());
+
+	/*
+	 * Wide kernels keep their tails with more coefficient bits, which accumulate in 64 bits
+	 */
+	EXPECT_EQ(0, (gaussianKernel<31, 7, std::int32_t>(6.0).horizontal[0]));
+	EXPECT_EQ(12, (gaussianKernel<31, 12, std::int64_t>(6.0).horizontal[0]));
+
+	Frame wide(64, 48);
+	std::fill(wide.data(), wide.data() + 64 * 48, U16F8::createFixedPoint(65535));
+	gaussianBlur<31, 12>(wide, blurred, 6.0, 2);
+	for (std::size_t i = 0; i < 64 * 48; ++i)
+	{
+		ASSERT_EQ(65535, blurred.data()[i].raw());
+	}
+
+	point(4, 4) = U16F8(128.0);
+	gaussianBlur<7, 12>(point, blurred, 1.5);
+	SeparableKernel<7, 7, 12, std::int64_t> fine = gaussianKernel<7, 12, std::int64_t>(1.5);
+	EXPECT_EQ(std::lround(32768.0 * fine.horizontal[1] * fine.horizontal[4] / (1 << 24)), blurred(2, 5).raw());
+
+	/*
+	 * 8 bit pixels get more coefficient bits within 32 bits
+	 */
+	FixedPointImage<std::uint8_t, 4> bytes(20, 20);
+	std::fill(bytes.data(), bytes.data() + 20 * 20, FixedPoint<std::uint8_t, 4>::createFixedPoint(255));
+	FixedPointImage<std::uint8_t, 4> blurred_bytes;
+	gaussianBlur<9>(bytes, blurred_bytes, 2.0);
+	for (std::size_t i = 0; i < 20 * 20; ++i)
+	{
+		ASSERT_EQ(255, blurred_bytes.data()[i].raw());
+	}
+}
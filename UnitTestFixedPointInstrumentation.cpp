@@ -0,0 +1,177 @@
+/*!
+    \file UnitTestFixedPointInstrumentation.cpp
+    \created 18/10/2026
+*/
+
+#define FIXEDPOINT_INSTRUMENTATION
+
+#include <FixedPoint.h>
+#include <RangedFixedPoint.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace
+{
+	/*!
+		\brief Find the report of the given line, or an empty report if there were no events on it
+	*/
+	FixedPointInstrumentation::SiteReport siteAt(std::uint32_t line)
+	{
+		for (const FixedPointInstrumentation::SiteReport& site : FixedPointInstrumentation::report())
+		{
+			if (site.line == line)
+			{
+				return site;
+			}
+		}
+
+		return FixedPointInstrumentation::SiteReport();
+	}
+}
+
+TEST(FixedPointInstrumentation, Truncation)
+{
+	FixedPointInstrumentation::reset();
+
+	/*
+	 * Converting 5.5625 from F4 to F2 drops the two low bits 01
+	 */
+	FixedPoint<std::int16_t, 4> s16f4(5.5625);
+	std::uint32_t line = __LINE__ + 1;
+	FixedPoint<std::int16_t, 2> s16f2 = s16f4.convert<std::int16_t, 2>();
+	EXPECT_EQ(5.5, s16f2.toDouble());
+
+	FixedPointInstrumentation::SiteReport site = siteAt(line);
+	EXPECT_EQ(1u, site.truncations);
+	EXPECT_EQ(1u, site.bitsLost);
+	EXPECT_EQ(0u, site.overflows);
+
+	/*
+	 * Exact conversions are not recorded
+	 */
+	FixedPoint<std::int16_t, 4> s16f4_exact(5.5);
+	line = __LINE__ + 1;
+	s16f4_exact.convert<std::int16_t, 2>();
+	EXPECT_EQ(0u, siteAt(line).truncations);
+}
+
+TEST(FixedPointInstrumentation, Overflow)
+{
+	FixedPointInstrumentation::reset();
+
+	/*
+	 * 100 does not fit into an 8 bit F4 number
+	 */
+	FixedPoint<std::int16_t, 4> s16f4(100.0);
+	std::uint32_t line = __LINE__ + 1;
+	s16f4.convert<std::int8_t, 4>();
+	EXPECT_EQ(1u, siteAt(line).overflows);
+
+	/*
+	 * Operators can not see their caller so their events are attributed to the enclosing site scope
+	 */
+	FixedPoint<std::int8_t, 4> s8f4_a(6.0);
+	FixedPoint<std::int8_t, 4> s8f4_b(3.0);
+
+	{
+		line = __LINE__ + 1;
+		FIXEDPOINT_SITE();
+		FixedPoint<std::int8_t, 4> sum = s8f4_a + s8f4_b;
+		FixedPoint<std::int8_t, 4> product = s8f4_a * s8f4_b;
+		FixedPoint<std::int8_t, 4> difference = s8f4_b - s8f4_a;
+		(void)sum;
+		(void)product;
+		(void)difference;
+	}
+
+	EXPECT_EQ(2u, siteAt(line).overflows);
+}
+
+TEST(FixedPointInstrumentation, WideFormats)
+{
+	FixedPointInstrumentation::reset();
+
+	/*
+	 * Products of full scale unsigned 32 bit operands are checked without overflowing the check itself
+	 */
+	FixedPoint<std::uint32_t, 8> u32f8 = FixedPoint<std::uint32_t, 8>::createFixedPoint(0xFFFFFFFFu);
+	std::uint32_t line;
+	{
+		line = __LINE__ + 1;
+		FIXEDPOINT_SITE();
+		FixedPoint<std::uint32_t, 8> square = u32f8 * u32f8;
+		(void)square;
+	}
+	EXPECT_EQ(1u, siteAt(line).overflows);
+
+	/*
+	 * 64 bit formats record their truncations and overflows
+	 */
+	FixedPoint<std::int64_t, 62> s64f62 = FixedPoint<std::int64_t, 62>::createFixedPoint(std::int64_t(3) << 60 | 5);
+	line = __LINE__ + 1;
+	FixedPoint<std::int64_t, 30> s64f30 = s64f62.convert<std::int64_t, 30>();
+	EXPECT_EQ(3.0 / 4, s64f30.toDouble());
+
+	FixedPointInstrumentation::SiteReport site = siteAt(line);
+	EXPECT_EQ(1u, site.truncations);
+	EXPECT_EQ(3u, site.bitsLost);
+	EXPECT_EQ(0u, site.overflows);
+
+	FixedPoint<std::int64_t, 30> s64f30_large(2.5);
+	line = __LINE__ + 1;
+	s64f30_large.convert<std::int64_t, 62>();
+	EXPECT_EQ(1u, siteAt(line).overflows);
+
+	FixedPoint<std::uint64_t, 32> u64f32 = FixedPoint<std::uint64_t, 32>::createFixedPoint(~std::uint64_t(0));
+	line = __LINE__ + 1;
+	u64f32.convert<std::uint64_t, 33>();
+	EXPECT_EQ(1u, siteAt(line).overflows);
+}
+
+TEST(FixedPointInstrumentation, Saturation)
+{
+	FixedPointInstrumentation::reset();
+
+	typedef RangedFixedPoint<std::int16_t, 8, -256, 256> Unit;
+
+	std::uint32_t line = __LINE__ + 1;
+	Unit::createClamped(FixedPoint<std::int16_t, 8>(2.0));
+	Unit::createClamped(FixedPoint<std::int16_t, 8>(0.5));
+	EXPECT_EQ(1u, siteAt(line).saturations);
+}
+
+TEST(FixedPointInstrumentation, ThreadMerge)
+{
+	FixedPointInstrumentation::reset();
+
+	/*
+	 * Each thread counts on its own and the counts are merged on report, including those of exited threads
+	 */
+	const std::uint32_t line = __LINE__ + 7;
+	auto work = []()
+	{
+		FixedPoint<std::int16_t, 4> s16f4(1.0625);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			s16f4.convert<std::int16_t, 1>();
+		}
+	};
+
+	std::thread first(work);
+	std::thread second(work);
+	first.join();
+	second.join();
+	work();
+
+	FixedPointInstrumentation::SiteReport site = siteAt(line);
+	EXPECT_EQ(3000u, site.truncations);
+	EXPECT_EQ(3000u, site.bitsLost);
+
+	std::ostringstream stream;
+	FixedPointInstrumentation::dump(stream);
+	EXPECT_NE(std::string::npos, stream.str().find("truncations: 3000"));
+}
@@ -0,0 +1,202 @@
+/*!
+    \file UnitTestFixedPointIntegrator.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointIntegrator.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	typedef FixedPoint<std::int64_t, 32> S64F32;
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+
+	/*!
+		\brief Harmonic oscillators x'' = -w^2 x with state (x, v) and w^2 = 1 + body / count
+	*/
+	template <typename T, std::int8_t F>
+	struct Oscillators
+	{
+		void operator()(const FixedPoint<T, F>&, const FixedPointBodies<T, F, 2>& state, std::size_t first, std::size_t last, FixedPointBodies<T, F, 2>& rate) const
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				T w2 = static_cast<T>((T(1) << F) + (static_cast<T>(i) << F) / static_cast<T>(state.size()));
+				rate(0, i) = state(1, i);
+				rate(1, i) = FixedPoint<T, F>::createFixedPoint(static_cast<T>(-IntegratorArithmetic<T, F>::multiply(w2, state(0, i).raw())));
+			}
+		}
+	};
+
+	/*!
+		\brief Bodies pulled toward the mean position of every body, so each acceleration depends on all positions
+	*/
+	struct Coupled
+	{
+		void operator()(const FixedPointBodies<std::int32_t, 16, 2>& positions, std::size_t first, std::size_t last, FixedPointBodies<std::int32_t, 16, 2>& accelerations) const
+		{
+			for (std::size_t d = 0; d < 2; ++d)
+			{
+				std::int64_t sum = 0;
+				for (std::size_t i = 0; i < positions.size(); ++i)
+				{
+					sum += positions(d, i).raw();
+				}
+
+				std::int32_t mean = static_cast<std::int32_t>(sum / static_cast<std::int64_t>(positions.size()));
+				for (std::size_t i = first; i < last; ++i)
+				{
+					accelerations(d, i) = S32F16::createFixedPoint(mean - positions(d, i).raw());
+				}
+			}
+		}
+	};
+
+	FixedPointBodies<std::int32_t, 16, 2> scatter(std::size_t count, std::int32_t seed)
+	{
+		FixedPointBodies<std::int32_t, 16, 2> bodies(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			bodies(0, i) = S32F16::createFixedPoint(static_cast<std::int32_t>((i * 7919 + seed) % 65536) - 32768);
+			bodies(1, i) = S32F16::createFixedPoint(static_cast<std::int32_t>((i * 104729 + seed) % 131072) - 65536);
+		}
+
+		return bodies;
+	}
+}
+
+TEST(FixedPointIntegrator, Bodies)
+{
+	FixedPointBodies<std::int32_t, 16, 3> bodies(5);
+	EXPECT_EQ(5u, bodies.size());
+	EXPECT_EQ(3u, (FixedPointBodies<std::int32_t, 16, 3>::COMPONENTS));
+
+	bodies(2, 4) = S32F16(1.5);
+	EXPECT_EQ(1.5, bodies.component(2)[4].toDouble());
+	EXPECT_EQ(0.0, bodies(0, 0).toDouble());
+}
+
+TEST(FixedPointIntegrator, RungeKutta4Accuracy)
+{
+	/*
+	 * Unit amplitude oscillators integrated over 2 time units with a step of 1/64 follow cos(wt) closely
+	 */
+	const std::size_t COUNT = 16;
+	FixedPointBodies<std::int64_t, 32, 2> state(COUNT);
+	for (std::size_t i = 0; i < COUNT; ++i)
+	{
+		state(0, i) = S64F32(1.0);
+	}
+
+	S64F32 time(0.0);
+	RungeKutta4<std::int64_t, 32, 2> integrator;
+	integrator.advance(Oscillators<std::int64_t, 32>(), state, time, S64F32(1.0 / 64), 128);
+
+	EXPECT_EQ(2.0, time.toDouble());
+	for (std::size_t i = 0; i < COUNT; ++i)
+	{
+		double w = std::sqrt(1.0 + static_cast<double>(i) / COUNT);
+		EXPECT_NEAR(std::cos(2.0 * w), state(0, i).toDouble(), 1e-7) << i;
+		EXPECT_NEAR(-w * std::sin(2.0 * w), state(1, i).toDouble(), 1e-7) << i;
+	}
+}
+
+TEST(FixedPointIntegrator, RungeKutta4Deterministic)
+{
+	/*
+	 * Every thread count produces the same bits
+	 */
+	const std::size_t COUNT = 1001;
+	FixedPointBodies<std::int32_t, 16, 2> reference = scatter(COUNT, 3);
+	S32F16 time(0.0);
+	RungeKutta4<std::int32_t, 16, 2>(1).advance(Oscillators<std::int32_t, 16>(), reference, time, S32F16(0.03125), 50);
+
+	for (std::size_t threads : { 2u, 3u, 8u })
+	{
+		FixedPointBodies<std::int32_t, 16, 2> state = scatter(COUNT, 3);
+		S32F16 t(0.0);
+		RungeKutta4<std::int32_t, 16, 2>(threads).advance(Oscillators<std::int32_t, 16>(), state, t, S32F16(0.03125), 50);
+
+		EXPECT_EQ(time.raw(), t.raw());
+		for (std::size_t i = 0; i < COUNT; ++i)
+		{
+			ASSERT_EQ(reference(0, i).raw(), state(0, i).raw()) << threads << " threads, body " << i;
+			ASSERT_EQ(reference(1, i).raw(), state(1, i).raw()) << threads << " threads, body " << i;
+		}
+	}
+}
+
+TEST(FixedPointIntegrator, VelocityVerletEnergy)
+{
+	/*
+	 * x'' = -x from x = 1 at rest: a symplectic step keeps the energy bounded over many periods
+	 */
+	FixedPointBodies<std::int64_t, 32, 1> positions(1);
+	FixedPointBodies<std::int64_t, 32, 1> velocities(1);
+	positions(0, 0) = S64F32(1.0);
+
+	auto spring = [](const FixedPointBodies<std::int64_t, 32, 1>& x, std::size_t first, std::size_t last, FixedPointBodies<std::int64_t, 32, 1>& a)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			a(0, i) = S64F32::createFixedPoint(-x(0, i).raw());
+		}
+	};
+
+	VelocityVerlet<std::int64_t, 32, 1> integrator;
+	for (int period = 0; period < 20; ++period)
+	{
+		integrator.advance(spring, positions, velocities, S64F32(0.0625), 100);
+
+		double x = positions(0, 0).toDouble();
+		double v = velocities(0, 0).toDouble();
+		EXPECT_NEAR(1.0, x * x + v * v, 2e-3) << period;
+	}
+
+	/*
+	 * After 2000 steps of 1/16 the phase follows cos(125)
+	 */
+	EXPECT_NEAR(std::cos(125.0), positions(0, 0).toDouble(), 0.05);
+}
+
+TEST(FixedPointIntegrator, VelocityVerletDeterministic)
+{
+	/*
+	 * Coupled bodies read every position between barriers, and every thread count produces the same bits
+	 */
+	const std::size_t COUNT = 777;
+	FixedPointBodies<std::int32_t, 16, 2> positions = scatter(COUNT, 11);
+	FixedPointBodies<std::int32_t, 16, 2> velocities = scatter(COUNT, 5);
+	VelocityVerlet<std::int32_t, 16, 2>(1).advance(Coupled(), positions, velocities, S32F16(0.015625), 200);
+
+	for (std::size_t threads : { 2u, 4u, 7u })
+	{
+		FixedPointBodies<std::int32_t, 16, 2> x = scatter(COUNT, 11);
+		FixedPointBodies<std::int32_t, 16, 2> v = scatter(COUNT, 5);
+		VelocityVerlet<std::int32_t, 16, 2>(threads).advance(Coupled(), x, v, S32F16(0.015625), 200);
+
+		for (std::size_t d = 0; d < 2; ++d)
+		{
+			for (std::size_t i = 0; i < COUNT; ++i)
+			{
+				ASSERT_EQ(positions(d, i).raw(), x(d, i).raw()) << threads << " threads, body " << i;
+				ASSERT_EQ(velocities(d, i).raw(), v(d, i).raw()) << threads << " threads, body " << i;
+			}
+		}
+	}
+
+	/*
+	 * More threads than bodies and no bodies at all
+	 */
+	FixedPointBodies<std::int32_t, 16, 2> few = scatter(3, 1);
+	FixedPointBodies<std::int32_t, 16, 2> slow = scatter(3, 2);
+	VelocityVerlet<std::int32_t, 16, 2>(16).advance(Coupled(), few, slow, S32F16(0.015625), 10);
+
+	FixedPointBodies<std::int32_t, 16, 2> none;
+	VelocityVerlet<std::int32_t, 16, 2>(4).advance(Coupled(), none, none, S32F16(0.015625), 10);
+	EXPECT_EQ(0u, none.size());
+}
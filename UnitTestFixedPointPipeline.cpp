@@ -0,0 +1,211 @@
+/*!
+    \file UnitTestFixedPointPipeline.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointPipeline.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+
+	/*!
+		\brief Source of n samples of a sawtooth, delivered in reads of at most capacity samples
+	*/
+	FixedPointPipeline<std::int32_t, 16>::Source sawtooth(std::size_t n)
+	{
+		std::shared_ptr<std::size_t> position = std::make_shared<std::size_t>(0);
+
+		return [n, position](std::int16_t* samples, std::size_t capacity)
+		{
+			std::size_t count = std::min(capacity, n - *position);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				samples[i] = static_cast<std::int16_t>(((*position + i) * 977) % 65536 - 32768);
+			}
+
+			*position += count;
+			return count;
+		};
+	}
+
+	std::vector<S32F16> runPipeline(std::size_t n, std::size_t chunk, bool threaded)
+	{
+		std::vector<S32F16> output;
+
+		FixedPointPipeline<std::int32_t, 16> pipeline(chunk);
+		pipeline.source<15>(sawtooth(n))
+			.filter({ S32F16(0.5), S32F16(0.25), S32F16(0.25) })
+			.decimate(3)
+			.sink([&output](const S32F16* values, std::size_t count)
+			{
+				output.insert(output.end(), values, values + count);
+			});
+
+		EXPECT_EQ(output.size(), pipeline.run(threaded));
+		return output;
+	}
+}
+
+TEST(FixedPointPipeline, RingBuffer)
+{
+	SpscRingBuffer<int> ring(3);
+
+	EXPECT_TRUE(ring.tryPush(1));
+	EXPECT_TRUE(ring.tryPush(2));
+	EXPECT_TRUE(ring.tryPush(3));
+	EXPECT_TRUE(ring.tryPush(4));
+	EXPECT_FALSE(ring.tryPush(5));
+
+	int value = 0;
+	EXPECT_TRUE(ring.tryPop(value));
+	EXPECT_EQ(1, value);
+	EXPECT_TRUE(ring.tryPush(5));
+
+	EXPECT_EQ(2, ring.pop());
+	EXPECT_EQ(3, ring.pop());
+	EXPECT_EQ(4, ring.pop());
+	EXPECT_EQ(5, ring.pop());
+	EXPECT_FALSE(ring.tryPop(value));
+
+	/*
+	 * Values cross between threads in order
+	 */
+	SpscRingBuffer<int> queue(8);
+	std::thread producer([&queue]()
+	{
+		for (int i = 0; i < 100000; ++i)
+		{
+			queue.push(i);
+		}
+	});
+
+	bool ordered = true;
+	for (int i = 0; i < 100000; ++i)
+	{
+		ordered = ordered && queue.pop() == i;
+	}
+	producer.join();
+
+	EXPECT_TRUE(ordered);
+}
+
+TEST(FixedPointPipeline, Stages)
+{
+	const std::size_t n = 1000;
+
+	/*
+	 * Reference computed over the whole stream at once
+	 */
+	std::vector<std::int16_t> samples(n);
+	sawtooth(n)(samples.data(), n);
+
+	std::vector<S32F16> expected;
+	for (std::size_t i = 0; i < n; i += 3)
+	{
+		std::int64_t sum = 0;
+		std::int64_t taps[3] = { 32768, 16384, 16384 };
+		for (std::size_t k = 0; k < 3 && k <= i; ++k)
+		{
+			sum += taps[k] * (static_cast<std::int64_t>(samples[i - k]) << 1);
+		}
+		expected.push_back(S32F16::createFixedPoint(static_cast<std::int32_t>(sum >> 16)));
+	}
+
+	/*
+	 * Chunk sizes that are not multiples of the decimation factor carry the filter history and decimation
+	 * phase across chunk boundaries
+	 */
+	for (std::size_t chunk : { std::size_t(1), std::size_t(7), std::size_t(100), std::size_t(4096) })
+	{
+		std::vector<S32F16> sequential = runPipeline(n, chunk, false);
+		std::vector<S32F16> threaded = runPipeline(n, chunk, true);
+
+		ASSERT_EQ(expected.size(), sequential.size()) << "chunk " << chunk;
+		ASSERT_EQ(expected.size(), threaded.size()) << "chunk " << chunk;
+
+		for (std::size_t i = 0; i < expected.size(); ++i)
+		{
+			EXPECT_EQ(expected[i].raw(), sequential[i].raw()) << "chunk " << chunk << ", value " << i;
+			EXPECT_EQ(expected[i].raw(), threaded[i].raw()) << "chunk " << chunk << ", value " << i;
+		}
+	}
+}
+
+TEST(FixedPointPipeline, EmptyStream)
+{
+	std::size_t calls = 0;
+
+	FixedPointPipeline<std::int16_t, 8> pipeline;
+	pipeline.source<8>([](std::int16_t*, std::size_t) { return std::size_t(0); })
+		.sink([&calls](const FixedPoint<std::int16_t, 8>*, std::size_t) { ++calls; });
+
+	EXPECT_EQ(0u, pipeline.run());
+	EXPECT_EQ(0u, pipeline.run(true));
+	EXPECT_EQ(0u, calls);
+}
+
+TEST(FixedPointPipeline, InvalidStages)
+{
+	/*
+	 * Empty filters and a decimation factor of zero are rejected when the stage is added
+	 */
+	FixedPointPipeline<std::int32_t, 16> pipeline;
+	EXPECT_THROW(pipeline.filter({}), std::invalid_argument);
+	EXPECT_THROW(pipeline.decimate(0), std::invalid_argument);
+
+	/*
+	 * A single tap and a factor of one pass the stream through
+	 */
+	std::vector<S32F16> out;
+	pipeline.source<8>(sawtooth(10))
+		.filter({ S32F16(1.0) })
+		.decimate(1)
+		.sink([&out](const S32F16* values, std::size_t count) { out.insert(out.end(), values, values + count); });
+
+	EXPECT_EQ(10u, pipeline.run());
+	ASSERT_EQ(10u, out.size());
+
+	std::vector<std::int16_t> samples(10);
+	sawtooth(10)(samples.data(), 10);
+	for (std::size_t i = 0; i < 10; ++i)
+	{
+		EXPECT_EQ(static_cast<std::int32_t>(samples[i]) << 8, out[i].raw());
+	}
+}
+
+TEST(FixedPointPipeline, FullScaleFilter)
+{
+	/*
+	 * Full scale 32 bit taps and samples give sums of products beyond 64 bits
+	 */
+	typedef FixedPoint<std::int32_t, 31> S32F31;
+	const std::int32_t LOWEST = std::numeric_limits<std::int32_t>::lowest();
+
+	std::vector<S32F31> out;
+	FixedPointPipeline<std::int32_t, 31> pipeline(4);
+	pipeline.source<15>([position = std::size_t(0)](std::int16_t* samples, std::size_t capacity) mutable
+		{
+			std::size_t count = std::min<std::size_t>(capacity, 8 - position);
+			std::fill(samples, samples + count, std::numeric_limits<std::int16_t>::lowest());
+			position += count;
+			return count;
+		})
+		.filter(std::vector<S32F31>(4, S32F31::createFixedPoint(LOWEST)))
+		.sink([&out](const S32F31* values, std::size_t count) { out.insert(out.end(), values, values + count); });
+
+	EXPECT_EQ(8u, pipeline.run());
+	ASSERT_EQ(8u, out.size());
+
+	__int128 square = static_cast<__int128>(LOWEST) * LOWEST;
+	for (std::size_t i = 0; i < out.size(); ++i)
+	{
+		__int128 terms = static_cast<__int128>(std::min<std::size_t>(i + 1, 4));
+		EXPECT_EQ(static_cast<std::int32_t>((terms * square) >> 31), out[i].raw()) << i;
+	}
+}
@@ -0,0 +1,214 @@
+/*!
+    \file UnitTestFixedPointRandom.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointRandom.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+TEST(FixedPointRandom, Philox)
+{
+	/*
+	 * Known answers of Philox4x32-10 from the reference implementation
+	 */
+	EXPECT_EQ((Philox4x32::Counter{ 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u }), Philox4x32::generate({ 0, 0, 0, 0 }, { 0, 0 }));
+	EXPECT_EQ((Philox4x32::Counter{ 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu }),
+		Philox4x32::generate({ 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu }, { 0xffffffffu, 0xffffffffu }));
+	EXPECT_EQ((Philox4x32::Counter{ 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u }),
+		Philox4x32::generate({ 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u }, { 0xa4093822u, 0x299f31d0u }));
+
+	/*
+	 * The batch form matches block by block, across the 32 bit boundary of the index
+	 */
+	const std::uint64_t INDEX = 0xFFFFFFF0ull;
+	const std::uint64_t STREAM = 0x0123456789ABCDEFull;
+	std::vector<std::uint32_t> words(4 * 37);
+	Philox4x32::generate(INDEX, STREAM, { 1, 2 }, words.data(), 37);
+
+	for (std::uint64_t b = 0; b < 37; ++b)
+	{
+		std::uint64_t index = INDEX + b;
+		Philox4x32::Counter block = Philox4x32::generate({ static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+			static_cast<std::uint32_t>(STREAM), static_cast<std::uint32_t>(STREAM >> 32) }, { 1, 2 });
+
+		for (std::size_t w = 0; w < 4; ++w)
+		{
+			ASSERT_EQ(block[w], words[4 * b + w]) << b;
+		}
+	}
+}
+
+TEST(FixedPointRandom, Streams)
+{
+	FixedPointRandom a(42, 7);
+	EXPECT_EQ(42u, a.seed());
+	EXPECT_EQ(7u, a.stream());
+
+	std::vector<std::uint32_t> sequence(1000);
+	for (std::uint32_t& word : sequence)
+	{
+		word = a.next32();
+	}
+
+	EXPECT_EQ(1000u, a.position());
+
+	/*
+	 * Bulk fills from any offset consume the same words as single draws
+	 */
+	FixedPointRandom b(42, 7);
+	EXPECT_EQ(sequence[0], b.next32());
+	EXPECT_EQ(sequence[1], b.next32());
+
+	std::vector<std::uint32_t> bulk(997);
+	b.fillWords(bulk.data(), bulk.size());
+	for (std::size_t i = 0; i < bulk.size(); ++i)
+	{
+		ASSERT_EQ(sequence[i + 2], bulk[i]) << i;
+	}
+
+	EXPECT_EQ(999u, b.position());
+	EXPECT_EQ(sequence[999], b.next32());
+
+	/*
+	 * Seeking is random access
+	 */
+	for (std::uint64_t position : { 0u, 3u, 4u, 513u, 998u })
+	{
+		b.seek(position);
+		EXPECT_EQ(position, b.position());
+		EXPECT_EQ(sequence[position], b.next32()) << position;
+	}
+
+	/*
+	 * Other streams and seeds differ
+	 */
+	FixedPointRandom c(42, 8);
+	FixedPointRandom d(43, 7);
+	int same = 0;
+	for (std::size_t i = 0; i < sequence.size(); ++i)
+	{
+		same += c.next32() == sequence[i];
+		same += d.next32() == sequence[i];
+	}
+
+	EXPECT_EQ(0, same);
+}
+
+TEST(FixedPointRandom, Uniform)
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+	typedef FixedPoint<std::int64_t, 48> S64F48;
+
+	/*
+	 * [0, 1) takes the top F bits of each draw
+	 */
+	FixedPointRandom words(1);
+	FixedPointRandom values(1);
+	for (int i = 0; i < 100; ++i)
+	{
+		std::uint32_t word = words.next32();
+		EXPECT_EQ(static_cast<std::int32_t>(word >> 16), (values.uniform<std::int32_t, 16>().raw()));
+	}
+
+	FixedPoint<std::int16_t, 15> q15 = values.uniform<std::int16_t, 15>();
+	EXPECT_GE(q15.raw(), 0);
+
+	/*
+	 * Means of bulk fills, which match single draws
+	 */
+	std::vector<S64F48> wide(100000);
+	FixedPointRandom bulk(2, 3);
+	bulk.fillUniform(wide.data(), wide.size());
+
+	FixedPointRandom single(2, 3);
+	double mean = 0.0;
+	for (const S64F48& value : wide)
+	{
+		ASSERT_EQ((single.uniform<std::int64_t, 48>().raw()), value.raw());
+		ASSERT_GE(value.toDouble(), 0.0);
+		ASSERT_LT(value.toDouble(), 1.0);
+		mean += value.toDouble();
+	}
+
+	EXPECT_NEAR(0.5, mean / wide.size(), 0.005);
+
+	/*
+	 * Ranges, down to a single raw value
+	 */
+	std::vector<S32F16> range(100000);
+	bulk.fillUniform(range.data(), range.size(), S32F16(-3.0), S32F16(5.0));
+
+	mean = 0.0;
+	for (const S32F16& value : range)
+	{
+		ASSERT_GE(value.toDouble(), -3.0);
+		ASSERT_LT(value.toDouble(), 5.0);
+		mean += value.toDouble();
+	}
+
+	EXPECT_NEAR(1.0, mean / range.size(), 0.05);
+
+	FixedPoint<std::uint8_t, 4> byte = bulk.uniform(FixedPoint<std::uint8_t, 4>(2.0), FixedPoint<std::uint8_t, 4>(2.0625));
+	EXPECT_EQ(2.0, byte.toDouble());
+
+	FixedPointRandom full(9);
+	FixedPointRandom raw(9);
+	EXPECT_EQ(static_cast<std::int16_t>(raw.next32()), (full.bits<std::int16_t, 8>().raw()));
+	EXPECT_EQ(static_cast<std::int64_t>(raw.next64()), (full.bits<std::int64_t, 8>().raw()));
+}
+
+TEST(FixedPointRandom, Gaussian)
+{
+	typedef FixedPoint<std::int32_t, 24> S32F24;
+
+	const std::size_t COUNT = 200000;
+	std::vector<S32F24> values(COUNT);
+	FixedPointRandom random(2026, 1);
+	random.fillGaussian(values.data(), values.size());
+
+	double sum = 0.0;
+	double squares = 0.0;
+	double fourths = 0.0;
+	std::size_t within = 0;
+
+	for (const S32F24& value : values)
+	{
+		double x = value.toDouble();
+		sum += x;
+		squares += x * x;
+		fourths += x * x * x * x;
+		within += std::fabs(x) < 1.0;
+	}
+
+	/*
+	 * Mean 0, variance 1, kurtosis 3 and 68.27% within one standard deviation
+	 */
+	EXPECT_NEAR(0.0, sum / COUNT, 0.01);
+	EXPECT_NEAR(1.0, squares / COUNT, 0.01);
+	EXPECT_NEAR(3.0, fourths / COUNT, 0.1);
+	EXPECT_NEAR(0.6827, static_cast<double>(within) / COUNT, 0.005);
+
+	/*
+	 * The same seed and stream reproduce the values, and narrow formats saturate
+	 */
+	FixedPointRandom again(2026, 1);
+	for (std::size_t i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(values[i].raw(), (again.gaussian<std::int32_t, 24>().raw()));
+	}
+
+	FixedPointRandom narrow(5);
+	for (int i = 0; i < 10000; ++i)
+	{
+		FixedPoint<std::int8_t, 6> x = narrow.gaussian<std::int8_t, 6>();
+		ASSERT_GE(x.raw(), -128);
+		ASSERT_LE(x.raw(), 127);
+	}
+
+	FixedPoint<std::int64_t, 50> precise = narrow.gaussian<std::int64_t, 50>();
+	EXPECT_LT(std::fabs(precise.toDouble()), 8.0);
+}
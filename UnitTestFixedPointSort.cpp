@@ -0,0 +1,150 @@
+/*!
+    \file UnitTestFixedPointSort.cpp
+    \created 18/10/2026
+*/
+
+#include <FixedPointSort.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+	template <typename T, std::int8_t F>
+	std::vector<FixedPoint<T, F>> randomValues(std::size_t count, std::uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::vector<FixedPoint<T, F>> values(count);
+		for (FixedPoint<T, F>& value : values)
+		{
+			value = FixedPoint<T, F>::createFixedPoint(static_cast<T>(generator()));
+		}
+
+		return values;
+	}
+
+	template <typename T, std::int8_t F>
+	std::vector<T> sortedRaw(const std::vector<FixedPoint<T, F>>& values)
+	{
+		std::vector<T> raw;
+		for (const FixedPoint<T, F>& value : values)
+		{
+			raw.push_back(value.raw());
+		}
+
+		std::sort(raw.begin(), raw.end());
+		return raw;
+	}
+
+	template <typename T, std::int8_t F>
+	void checkSort(std::size_t count)
+	{
+		std::vector<FixedPoint<T, F>> values = randomValues<T, F>(count, static_cast<std::uint32_t>(count));
+		std::vector<T> expected = sortedRaw(values);
+
+		radixSort(values.data(), values.size());
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			ASSERT_EQ(expected[i], values[i].raw()) << i;
+		}
+	}
+}
+
+TEST(FixedPointSort, RadixSort)
+{
+	checkSort<std::int8_t, 4>(1000);
+	checkSort<std::uint8_t, 4>(1000);
+	checkSort<std::int16_t, 8>(10007);
+	checkSort<std::uint16_t, 8>(10007);
+	checkSort<std::int32_t, 16>(100003);
+	checkSort<std::uint32_t, 16>(100003);
+	checkSort<std::int64_t, 32>(10007);
+	checkSort<std::int32_t, 16>(0);
+	checkSort<std::int32_t, 16>(1);
+
+	/*
+	 * Values in a narrow range skip the digits they share
+	 */
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+	std::vector<S32F16> narrow = { S32F16(-0.5), S32F16(1.0), S32F16(-1.5), S32F16(0.25), S32F16(-0.5) };
+	radixSort(narrow.data(), narrow.size());
+	EXPECT_EQ(-1.5, narrow[0].toDouble());
+	EXPECT_EQ(-0.5, narrow[1].toDouble());
+	EXPECT_EQ(-0.5, narrow[2].toDouble());
+	EXPECT_EQ(0.25, narrow[3].toDouble());
+	EXPECT_EQ(1.0, narrow[4].toDouble());
+}
+
+TEST(FixedPointSort, Histogram)
+{
+	typedef FixedPoint<std::int16_t, 8> S16F8;
+
+	/*
+	 * Four bins over [-128, 128) of 64 each
+	 */
+	std::vector<S16F8> values = { S16F8(-128.0), S16F8(-64.5), S16F8(-0.5), S16F8(0.0), S16F8(63.9), S16F8(64.0), S16F8(127.0) };
+	std::uint64_t bins[4] = {};
+	histogram<2>(values.data(), values.size(), bins);
+
+	EXPECT_EQ(2u, bins[0]);
+	EXPECT_EQ(1u, bins[1]);
+	EXPECT_EQ(2u, bins[2]);
+	EXPECT_EQ(2u, bins[3]);
+
+	std::vector<S16F8> random = randomValues<std::int16_t, 8>(100001, 7);
+	std::vector<std::uint64_t> fine(256, 0);
+	histogram<8>(random.data(), random.size(), fine.data());
+
+	std::vector<std::uint64_t> expected(256, 0);
+	for (const S16F8& value : random)
+	{
+		++expected[static_cast<std::size_t>(value.raw() + 32768) >> 8];
+	}
+
+	EXPECT_EQ(expected, fine);
+}
+
+TEST(FixedPointSort, OrderStatistics)
+{
+	std::vector<FixedPoint<std::int32_t, 16>> values = randomValues<std::int32_t, 16>(50001, 3);
+	std::vector<std::int32_t> sorted = sortedRaw(values);
+	std::vector<FixedPoint<std::int32_t, 16>> original = values;
+
+	for (std::size_t n : { std::size_t(0), std::size_t(1), std::size_t(12345), std::size_t(25000), std::size_t(50000) })
+	{
+		EXPECT_EQ(sorted[n], nthElement(values.data(), values.size(), n).raw()) << n;
+	}
+
+	EXPECT_EQ(sorted[25000], median(values.data(), values.size()).raw());
+	EXPECT_EQ(sorted[0], percentile(values.data(), values.size(), 0.0).raw());
+	EXPECT_EQ(sorted[49500], percentile(values.data(), values.size(), 99.0).raw());
+	EXPECT_EQ(sorted[50000], percentile(values.data(), values.size(), 100.0).raw());
+
+	/*
+	 * Selection leaves the input untouched
+	 */
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		ASSERT_EQ(original[i].raw(), values[i].raw());
+	}
+
+	/*
+	 * Duplicates and the lower median of an even count
+	 */
+	typedef FixedPoint<std::uint8_t, 4> U8F4;
+	std::vector<U8F4> small = { U8F4(3.0), U8F4(1.0), U8F4(3.0), U8F4(2.0) };
+	EXPECT_EQ(2.0, median(small.data(), small.size()).toDouble());
+	EXPECT_EQ(3.0, nthElement(small.data(), small.size(), 3).toDouble());
+
+	/*
+	 * Positions past the end give the largest number, as percentile does above 100
+	 */
+	EXPECT_EQ(3.0, nthElement(small.data(), small.size(), 4).toDouble());
+	EXPECT_EQ(3.0, nthElement(small.data(), small.size(), std::size_t(-1)).toDouble());
+	EXPECT_EQ(sorted[50000], nthElement(values.data(), values.size(), 50001).raw());
+	EXPECT_EQ(sorted[50000], percentile(values.data(), values.size(), 150.0).raw());
+}
@@ -0,0 +1,138 @@
+/*!
+    \file UnitTestLookupTable.cpp
+    \created 18/10/2026
+*/
+
+#include <LookupTable.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+TEST(LookupTable, Breakpoints)
+{
+	/*
+	 * 16 intervals over [-4, 4) of a signed F13 input, and over [0, 8) of an unsigned one
+	 */
+	typedef LookupTable<std::int16_t, 13, 4> Signed;
+	typedef LookupTable<std::uint16_t, 13, 4> Unsigned;
+
+	EXPECT_EQ(17u, Signed::POINTS);
+	EXPECT_EQ(-4.0, Signed::breakpoint(0));
+	EXPECT_EQ(-3.5, Signed::breakpoint(1));
+	EXPECT_EQ(4.0, Signed::breakpoint(16));
+	EXPECT_EQ(0.0, Unsigned::breakpoint(0));
+	EXPECT_EQ(8.0, Unsigned::breakpoint(16));
+
+	/*
+	 * Built at compile time from a constexpr function
+	 */
+	static constexpr Signed square = Signed::create([](double x) { return x * x / 8; });
+	static_assert(square.raw(0) == 2 << 13, "Breakpoints are computed at compile time");
+	static_assert(square.raw(8) == 0, "Breakpoints are computed at compile time");
+
+	EXPECT_EQ(2.0, square.linear(FixedPoint<std::int16_t, 13>(-4.0)).toDouble());
+	EXPECT_EQ(0.0, square.linear(FixedPoint<std::int16_t, 13>(0.0)).toDouble());
+
+	/*
+	 * Between breakpoints 1 and 1.5 the chord of x^2 / 8 at 1.25 is 0.203125
+	 */
+	EXPECT_EQ(0.203125, square.linear(FixedPoint<std::int16_t, 13>(1.25)).toDouble());
+
+	/*
+	 * The cubic reproduces the quadratic exactly between interior breakpoints
+	 */
+	EXPECT_EQ(0.1953125, square.cubic(FixedPoint<std::int16_t, 13>(1.25)).toDouble());
+
+	/*
+	 * A cubic overshooting the largest or lowest value saturates rather than wrapping
+	 */
+	typedef LookupTable<std::int16_t, 13, 2> Coarse;
+	const std::int16_t MAX = std::numeric_limits<std::int16_t>::max();
+	const std::int16_t LOWEST = std::numeric_limits<std::int16_t>::lowest();
+
+	Coarse plateau = Coarse::createFromBreakpoints({ 0, MAX, MAX, 0, 0 });
+	EXPECT_EQ(MAX, plateau.linear(FixedPoint<std::int16_t, 13>(-1.0)).raw());
+	EXPECT_EQ(MAX, plateau.cubic(FixedPoint<std::int16_t, 13>(-1.0)).raw());
+
+	Coarse trough = Coarse::createFromBreakpoints({ 0, LOWEST, LOWEST, 0, 0 });
+	EXPECT_EQ(LOWEST, trough.cubic(FixedPoint<std::int16_t, 13>(-1.0)).raw());
+
+	typedef LookupTable<std::int16_t, 13, 2, std::uint16_t, 8> Positive;
+	Positive dip = Positive::createFromBreakpoints({ 60000, 0, 0, 60000, 60000 });
+	EXPECT_EQ(0, dip.cubic(FixedPoint<std::int16_t, 13>(-1.0)).raw());
+}
+
+TEST(LookupTable, Accuracy)
+{
+	typedef FixedPoint<std::int32_t, 28> S32F28;
+	typedef LookupTable<std::int32_t, 28, 8, std::int32_t, 24> Sine;
+
+	const Sine sine = Sine::create([](double x) { return std::sin(x); });
+
+	double linear_error = 0.0;
+	double cubic_error = 0.0;
+
+	std::vector<S32F28> inputs;
+	for (double x = -7.9; x < 7.9; x += 0.001)
+	{
+		inputs.push_back(S32F28(x));
+	}
+
+	std::vector<FixedPoint<std::int32_t, 24>> linear(inputs.size());
+	std::vector<FixedPoint<std::int32_t, 24>> cubic(inputs.size());
+	sine.linear(inputs.data(), linear.data(), inputs.size());
+	sine.cubic(inputs.data(), cubic.data(), inputs.size());
+
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+	{
+		double expected = std::sin(inputs[i].toDouble());
+		linear_error = std::max(linear_error, std::fabs(linear[i].toDouble() - expected));
+		cubic_error = std::max(cubic_error, std::fabs(cubic[i].toDouble() - expected));
+
+		EXPECT_EQ(linear[i].raw(), sine.linear(inputs[i]).raw());
+	}
+
+	/*
+	 * With a step of 1/16 the chord error is bounded by h^2 / 8 and the cubic error is far smaller
+	 */
+	EXPECT_LT(linear_error, 1.0 / 2000);
+	EXPECT_LT(cubic_error, 1.0 / 65536);
+}
+
+TEST(LookupTable, Breakpoints2D)
+{
+	typedef FixedPoint<std::int16_t, 12> S16F12;
+	typedef LookupTable2D<std::int16_t, 12, 4, 3> Table;
+
+	/*
+	 * Bilinear interpolation reproduces a bilinear function exactly
+	 */
+	static constexpr Table table = Table::create([](double x, double y) { return x * y / 16 + x / 8 - 0.5; });
+	EXPECT_EQ(17u, Table::X_POINTS);
+	EXPECT_EQ(9u, Table::Y_POINTS);
+
+	for (double x = -8.0; x < 8.0; x += 0.375)
+	{
+		for (double y = -8.0; y < 8.0; y += 0.625)
+		{
+			EXPECT_EQ(x * y / 16 + x / 8 - 0.5, table.bilinear(S16F12(x), S16F12(y)).toDouble()) << x << ", " << y;
+		}
+	}
+
+	S16F12 xs[2] = { S16F12(1.0), S16F12(-2.0) };
+	S16F12 ys[2] = { S16F12(4.0), S16F12(0.5) };
+	S16F12 out[2];
+	table.bilinear(xs, ys, out, 2);
+	EXPECT_EQ(-0.125, out[0].toDouble());
+	EXPECT_EQ(-0.8125, out[1].toDouble());
+
+	/*
+	 * Raw breakpoint data, at inputs 0, 4, 8, 12 and 16
+	 */
+	typedef LookupTable<std::uint8_t, 4, 2> Small;
+	Small ramp = Small::createFromBreakpoints({ 0, 16, 64, 32, 0 });
+	EXPECT_EQ(2.5, ramp.linear(FixedPoint<std::uint8_t, 4>(6.0)).toDouble());
+	EXPECT_EQ(3.5, ramp.linear(FixedPoint<std::uint8_t, 4>(9.0)).toDouble());
+}
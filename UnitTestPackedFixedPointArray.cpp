@@ -0,0 +1,131 @@
+/*!
+    \file UnitTestPackedFixedPointArray.cpp
+    \created 18/10/2026
+*/
+
+#include <PackedFixedPointArray.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(PackedFixedPointArray, Layout)
+{
+	/*
+	 * Two 12 bit samples pack into three bytes, least significant bits first
+	 */
+	PackedFixedPointArray<12, 4, false> u12f4(2);
+	u12f4.set(0, FixedPoint<std::uint16_t, 4>::createFixedPoint(0xABC));
+	u12f4.set(1, FixedPoint<std::uint16_t, 4>::createFixedPoint(0x123));
+
+	EXPECT_EQ(3u, u12f4.bytes());
+	EXPECT_EQ(0xBC, u12f4.data()[0]);
+	EXPECT_EQ(0x3A, u12f4.data()[1]);
+	EXPECT_EQ(0x12, u12f4.data()[2]);
+
+	EXPECT_EQ(0xABC, u12f4.get(0).raw());
+	EXPECT_EQ(0x123, u12f4.get(1).raw());
+
+	PackedFixedPointArray<24, 8, true> s24f8(1000);
+	EXPECT_EQ(3000u, s24f8.bytes());
+
+	PackedFixedPointArray<20, 8, true> s20f8(7);
+	EXPECT_EQ(18u, s20f8.bytes());
+}
+
+TEST(PackedFixedPointArray, RandomAccess)
+{
+	/*
+	 * Signed values are sign extended into the 16 bit type and written back through the proxy
+	 */
+	typedef FixedPoint<std::int16_t, 4> S16F4;
+
+	PackedFixedPointArray<12, 4, true> s12f4(5);
+	s12f4[0] = S16F4(-3.5);
+	s12f4[1] = S16F4(127.9375);
+	s12f4[2] = S16F4(-128.0);
+	s12f4[3] = s12f4[0];
+
+	EXPECT_EQ(-3.5, S16F4(s12f4[0]).toDouble());
+	EXPECT_EQ(127.9375, S16F4(s12f4[1]).toDouble());
+	EXPECT_EQ(-128.0, S16F4(s12f4[2]).toDouble());
+	EXPECT_EQ(-3.5, S16F4(s12f4[3]).toDouble());
+	EXPECT_EQ(0.0, S16F4(s12f4[4]).toDouble());
+
+	/*
+	 * Neighbouring elements sharing a byte are left untouched
+	 */
+	s12f4[1] = S16F4(0.0);
+	EXPECT_EQ(-3.5, s12f4.get(0).toDouble());
+	EXPECT_EQ(-128.0, s12f4.get(2).toDouble());
+
+	PackedFixedPointArray<24, 8, true> s24f8(3);
+	s24f8[1] = FixedPoint<std::int32_t, 8>(-32768.0);
+	EXPECT_EQ(-32768.0, s24f8.get(1).toDouble());
+	EXPECT_EQ(0.0, s24f8.get(0).toDouble());
+	EXPECT_EQ(0.0, s24f8.get(2).toDouble());
+}
+
+template <int Bits, bool Signed>
+void checkBlocks()
+{
+	typedef PackedFixedPointArray<Bits, 1, Signed> Array;
+	typedef typename Array::value_type Value;
+
+	const std::size_t count = 203;
+	std::vector<Value> values(count);
+	std::int64_t low = Signed ? -(std::int64_t(1) << (Bits - 1)) : 0;
+	std::int64_t range = std::int64_t(1) << Bits;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		values[i] = Value::createFixedPoint(static_cast<typename Array::ValueType>(low + (std::int64_t(i) * 2654435761) % range));
+	}
+
+	/*
+	 * Pack and unpack starting away from a group boundary to cover the partial groups at both ends
+	 */
+	Array array(count + 5);
+	array.pack(3, count, values.data());
+
+	std::vector<Value> unpacked(count);
+	array.unpack(3, count, unpacked.data());
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		EXPECT_EQ(values[i].raw(), unpacked[i].raw()) << Bits << " bits, element " << i;
+		EXPECT_EQ(values[i].raw(), array.get(i + 3).raw()) << Bits << " bits, element " << i;
+	}
+
+	EXPECT_EQ(0, array.get(0).raw());
+	EXPECT_EQ(0, array.get(count + 4).raw());
+}
+
+TEST(PackedFixedPointArray, Blocks)
+{
+	checkBlocks<12, true>();
+	checkBlocks<12, false>();
+	checkBlocks<20, true>();
+	checkBlocks<24, true>();
+	checkBlocks<24, false>();
+	checkBlocks<32, true>();
+	checkBlocks<3, false>();
+}
+
+TEST(PackedFixedPointArray, Resize)
+{
+	PackedFixedPointArray<12, 4, true> s12f4(3);
+	s12f4[0] = FixedPoint<std::int16_t, 4>(1.0);
+	s12f4[1] = FixedPoint<std::int16_t, 4>(-1.0);
+	s12f4[2] = FixedPoint<std::int16_t, 4>(2.0);
+
+	/*
+	 * Elements removed by shrinking come back as zero
+	 */
+	s12f4.resize(1);
+	s12f4.resize(4);
+	EXPECT_EQ(1.0, s12f4.get(0).toDouble());
+	EXPECT_EQ(0.0, s12f4.get(1).toDouble());
+	EXPECT_EQ(0.0, s12f4.get(2).toDouble());
+	EXPECT_EQ(0.0, s12f4.get(3).toDouble());
+}
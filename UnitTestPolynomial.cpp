@@ -0,0 +1,111 @@
+/*!
+    \file UnitTestPolynomial.cpp
+    \created 18/10/2026
+*/
+
+#include <Polynomial.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+
+	double reference(const std::vector<double>& coefficients, double x)
+	{
+		double result = 0.0;
+		for (std::size_t i = coefficients.size(); i > 0; --i)
+		{
+			result = result * x + coefficients[i - 1];
+		}
+
+		return result;
+	}
+
+	/*!
+		\brief Value of a Q15 number, read from the raw value since ONE does not fit in 16 signed bits
+	*/
+	double q15(const FixedPoint<std::int16_t, 15>& value)
+	{
+		return value.raw() / 32768.0;
+	}
+}
+
+TEST(Polynomial, Coefficients)
+{
+	EXPECT_EQ(32768, (fixedPointRaw<std::int32_t, 16>(0.5)));
+	EXPECT_EQ(-98304, (fixedPointRaw<std::int32_t, 16>(-1.5)));
+	EXPECT_EQ(1, (fixedPointRaw<std::int16_t, 8>(1.0 / 256)));
+
+	/*
+	 * A constant polynomial returns its coefficient whatever the input
+	 */
+	typedef Polynomial<std::int32_t, 16, fixedPointRaw<std::int32_t, 16>(-2.25)> Constant;
+	EXPECT_EQ(-2.25, Constant::horner(S32F16(100.0)).toDouble());
+	EXPECT_EQ(-2.25, Constant::estrin(S32F16(-3.0)).toDouble());
+}
+
+TEST(Polynomial, Calibration)
+{
+	/*
+	 * A cubic sensor calibration over inputs of magnitude up to 4, against double evaluation
+	 */
+	typedef BoundedPolynomial<std::int32_t, 16, 4 << 16,
+		fixedPointRaw<std::int32_t, 16>(0.125),
+		fixedPointRaw<std::int32_t, 16>(1.0078125),
+		fixedPointRaw<std::int32_t, 16>(-0.03125),
+		fixedPointRaw<std::int32_t, 16>(0.0029296875)> Cubic;
+
+	const std::vector<double> coefficients = { 0.125, 1.0078125, -0.03125, 0.0029296875 };
+
+	for (double x = -4.0; x < 4.0; x += 0.0078125 * 3)
+	{
+		S32F16 input(x);
+		double expected = reference(coefficients, input.toDouble());
+
+		EXPECT_NEAR(expected, Cubic::horner(input).toDouble(), 2.0 / 65536) << x;
+		EXPECT_NEAR(expected, Cubic::estrin(input).toDouble(), 2.0 / 65536) << x;
+		EXPECT_NEAR(expected, Cubic()(input).toDouble(), 2.0 / 65536) << x;
+	}
+
+	/*
+	 * Intermediates grow in range towards the constant term so they get fewer fractional bits
+	 */
+	EXPECT_GT(Cubic::hornerFraction(3), Cubic::hornerFraction(0));
+}
+
+TEST(Polynomial, FullRange)
+{
+	/*
+	 * Over the whole 16 bit format the quintic reaches close to the limit without overflowing any intermediate
+	 */
+	typedef Polynomial<std::int16_t, 15,
+		fixedPointRaw<std::int16_t, 15>(0.0),
+		fixedPointRaw<std::int16_t, 15>(0.5),
+		fixedPointRaw<std::int16_t, 15>(0.0),
+		fixedPointRaw<std::int16_t, 15>(-0.25),
+		fixedPointRaw<std::int16_t, 15>(0.125),
+		fixedPointRaw<std::int16_t, 15>(0.5)> Quintic;
+
+	const std::vector<double> coefficients = { 0.0, 0.5, 0.0, -0.25, 0.125, 0.5 };
+
+	std::vector<FixedPoint<std::int16_t, 15>> inputs;
+	for (std::int32_t raw = -32768; raw < 32768; raw += 17)
+	{
+		inputs.push_back(FixedPoint<std::int16_t, 15>::createFixedPoint(static_cast<std::int16_t>(raw)));
+	}
+
+	std::vector<FixedPoint<std::int16_t, 15>> outputs(inputs.size());
+	Quintic::evaluate(inputs.data(), outputs.data(), inputs.size());
+
+	for (std::size_t i = 0; i < inputs.size(); ++i)
+	{
+		double expected = reference(coefficients, q15(inputs[i]));
+
+		EXPECT_NEAR(expected, q15(outputs[i]), 1.0 / 32768) << q15(inputs[i]);
+		EXPECT_NEAR(expected, q15(Quintic::estrin(inputs[i])), 1.0 / 32768) << q15(inputs[i]);
+	}
+}
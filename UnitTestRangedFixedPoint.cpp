@@ -0,0 +1,106 @@
+/*!
+    \file UnitTestRangedFixedPoint.cpp
+    \created 18/10/2026
+*/
+
+#include <RangedFixedPoint.h>
+
+#include <gtest/gtest.h>
+
+/*
+	The ranges below are given as raw values, so with F6 a range of -64 to 64 is -1.0 to 1.0
+*/
+
+TEST(RangedFixedPoint, StorageSelection)
+{
+	EXPECT_EQ(8, rangeBits(-128, 127));
+	EXPECT_EQ(9, rangeBits(-128, 128));
+	EXPECT_EQ(8, rangeBits(0, 255));
+	EXPECT_EQ(9, rangeBits(0, 256));
+	EXPECT_EQ(1, rangeBits(0, 0));
+	EXPECT_EQ(32, rangeBits(std::numeric_limits<std::int32_t>::min(), 0));
+
+	EXPECT_TRUE((std::is_same<RangedSelector<4, -100, 100>::Type, RangedFixedPoint<std::int8_t, 4, -100, 100>>::value));
+	EXPECT_TRUE((std::is_same<RangedSelector<4, 0, 200>::Type, RangedFixedPoint<std::uint8_t, 4, 0, 200>>::value));
+	EXPECT_TRUE((std::is_same<RangedSelector<4, -200, 200>::Type, RangedFixedPoint<std::int16_t, 4, -200, 200>>::value));
+	EXPECT_TRUE((std::is_same<RangedSelector<4, 0, 70000>::Type, RangedFixedPoint<std::uint32_t, 4, 0, 70000>>::value));
+}
+
+TEST(RangedFixedPoint, Addition)
+{
+	typedef RangedFixedPoint<std::int8_t, 6, -64, 64> Unit;
+
+	Unit a = Unit::createClamped(FixedPoint<std::int8_t, 6>(0.75));
+	Unit b = Unit::createClamped(FixedPoint<std::int8_t, 6>(0.5));
+
+	/*
+	 * Two values of [-1, 1] sum to [-2, 2] which no longer fits in 8 bits with F6, so the storage grows
+	 */
+	auto c = a + b;
+	EXPECT_TRUE((std::is_same<decltype(c), RangedFixedPoint<std::int16_t, 6, -128, 128>>::value));
+	EXPECT_EQ(1.25, c.toDouble());
+
+	auto d = b - a;
+	EXPECT_TRUE((std::is_same<decltype(d), RangedFixedPoint<std::int16_t, 6, -128, 128>>::value));
+	EXPECT_EQ(-0.25, d.toDouble());
+
+	/*
+	 * Differing fractional amounts keep the larger and align the other operand
+	 */
+	typedef RangedFixedPoint<std::uint8_t, 2, 0, 40> Coarse;
+	Coarse e = Coarse::createConstant<10>();
+
+	auto f = a + e;
+	EXPECT_TRUE((std::is_same<decltype(f), RangedFixedPoint<std::int16_t, 6, -64, 704>>::value));
+	EXPECT_EQ(3.25, f.toDouble());
+
+	auto g = -e;
+	EXPECT_TRUE((std::is_same<decltype(g), RangedFixedPoint<std::int8_t, 2, -40, 0>>::value));
+	EXPECT_EQ(-2.5, g.toDouble());
+}
+
+TEST(RangedFixedPoint, Multiplication)
+{
+	typedef RangedFixedPoint<std::int8_t, 6, -64, 64> Unit;
+
+	/*
+	 * The product of two values of [-1, 1] stays within [-1, 1] so it stays in 8 bits, and the full precision
+	 * product is formed in 16 bits rather than the 32 or 64 bits a blind widening would pick
+	 */
+	Unit a = Unit::createClamped(FixedPoint<std::int8_t, 6>(-0.75));
+	Unit b = Unit::createClamped(FixedPoint<std::int8_t, 6>(0.5));
+
+	auto c = a * b;
+	EXPECT_TRUE((std::is_same<decltype(c), Unit>::value));
+	EXPECT_EQ(-0.375, c.toDouble());
+	EXPECT_TRUE((std::is_same<RangedArithmetic<6, -64, 64, 6, -64, 64>::Product, std::int16_t>::value));
+
+	typedef RangedFixedPoint<std::uint16_t, 8, 0, 2560> Gain;
+	Gain gain = Gain::createClamped(FixedPoint<std::uint16_t, 8>(7.5));
+
+	auto d = a * gain;
+	EXPECT_TRUE((std::is_same<decltype(d), RangedFixedPoint<std::int16_t, 8, -2560, 2560>>::value));
+	EXPECT_EQ(-5.625, d.toDouble());
+
+	/*
+	 * Two negative ranges give an unsigned 16 bit product, which is still formed without overflow
+	 */
+	typedef RangedFixedPoint<std::int16_t, 2, -200, -1> Negative;
+	EXPECT_TRUE((std::is_same<RangedArithmetic<2, -200, -1, 2, -200, -1>::Product, std::uint16_t>::value));
+
+	Negative e = Negative::createClamped(FixedPoint<std::int16_t, 2>(-50.0));
+	Negative f = Negative::createClamped(FixedPoint<std::int16_t, 2>(-49.75));
+	EXPECT_EQ(2487.5, (e * f).toDouble());
+}
+
+TEST(RangedFixedPoint, Clamping)
+{
+	typedef RangedFixedPoint<std::int16_t, 8, -256, 512> Range;
+
+	EXPECT_EQ(-1.0, Range::createClamped(FixedPoint<std::int16_t, 8>(-3.0)).toDouble());
+	EXPECT_EQ(2.0, Range::createClamped(FixedPoint<std::int16_t, 8>(5.0)).toDouble());
+	EXPECT_EQ(1.5, Range::createClamped(FixedPoint<std::int16_t, 8>(1.5)).toDouble());
+
+	EXPECT_EQ(0, Range().raw());
+	EXPECT_EQ(16, (RangedFixedPoint<std::uint8_t, 4, 16, 32>().raw()));
+}
@@ -0,0 +1,203 @@
+/*!
+    \file UnitTestRunningStats.cpp
+    \created 18/10/2026
+*/
+
+#include <RunningStats.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	template <typename T, std::int8_t F>
+	std::vector<FixedPoint<T, F>> randomSamples(std::size_t count, std::uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::vector<FixedPoint<T, F>> samples(count);
+		for (FixedPoint<T, F>& sample : samples)
+		{
+			sample = FixedPoint<T, F>::createFixedPoint(static_cast<T>(generator()));
+		}
+
+		samples[0] = FixedPoint<T, F>::createFixedPoint(std::numeric_limits<T>::min());
+		samples[1] = FixedPoint<T, F>::createFixedPoint(std::numeric_limits<T>::max());
+
+		return samples;
+	}
+
+	/*!
+		\brief Batches, single samples and merged partials all give the same exact sums
+	*/
+	template <typename T, std::int8_t F>
+	void checkExact()
+	{
+		std::vector<FixedPoint<T, F>> samples = randomSamples<T, F>(10001, sizeof(T));
+
+		RunningStats<T, F> single;
+		__int128 sum = 0;
+		unsigned __int128 squares = 0;
+		for (const FixedPoint<T, F>& sample : samples)
+		{
+			single.add(sample);
+			sum += sample.raw();
+			squares += static_cast<unsigned __int128>(static_cast<__int128>(sample.raw()) * sample.raw());
+		}
+
+		RunningStats<T, F> batch;
+		batch.add(samples.data(), samples.size());
+
+		RunningStats<T, F> merged;
+		for (std::size_t first = 0; first < samples.size(); first += 999)
+		{
+			RunningStats<T, F> partial;
+			partial.add(samples.data() + first, std::min<std::size_t>(999, samples.size() - first));
+			merged.merge(partial);
+		}
+
+		for (const RunningStats<T, F>* stats : { &single, &batch, &merged })
+		{
+			EXPECT_EQ(samples.size(), stats->count());
+			EXPECT_TRUE(sum == stats->sum());
+			EXPECT_TRUE(squares == stats->sumSquares());
+			EXPECT_EQ(std::numeric_limits<T>::min(), stats->min().raw());
+			EXPECT_EQ(std::numeric_limits<T>::max(), stats->max().raw());
+		}
+	}
+}
+
+TEST(RunningStats, Exact)
+{
+	checkExact<std::int8_t, 4>();
+	checkExact<std::uint8_t, 4>();
+	checkExact<std::int16_t, 8>();
+	checkExact<std::uint16_t, 8>();
+	checkExact<std::int32_t, 16>();
+	checkExact<std::uint32_t, 16>();
+}
+
+TEST(RunningStats, Statistics)
+{
+	typedef FixedPoint<std::int32_t, 16> S32F16;
+
+	/*
+	 * 2, 4, 4, 4, 5, 5, 7, 9 has mean 5, variance 4, sample variance 32 / 7 and RMS sqrt(29)
+	 */
+	RunningStats<std::int32_t, 16> stats;
+	for (double x : { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 })
+	{
+		stats.add(S32F16(x));
+	}
+
+	EXPECT_EQ(5.0, stats.mean().toDouble());
+	EXPECT_EQ(4.0, stats.variance().toDouble());
+	EXPECT_EQ(2.0, stats.standardDeviation().toDouble());
+	EXPECT_EQ(std::lround(32.0 / 7 * 65536), stats.sampleVariance().raw());
+	EXPECT_EQ(std::lround(std::sqrt(29.0) * 65536), stats.rms().raw());
+	EXPECT_EQ(2.0, stats.min().toDouble());
+	EXPECT_EQ(9.0, stats.max().toDouble());
+
+	/*
+	 * Rounding of the mean and agreement with long double on random data
+	 */
+	RunningStats<std::int32_t, 16> ties;
+	ties.add(S32F16::createFixedPoint(-1));
+	ties.add(S32F16::createFixedPoint(-2));
+	EXPECT_EQ(-2, ties.mean().raw());
+
+	std::vector<S32F16> samples(100000);
+	std::mt19937 generator(7);
+	std::normal_distribution<double> normal(-3.25, 1.5);
+	for (S32F16& sample : samples)
+	{
+		sample = S32F16(normal(generator));
+	}
+
+	RunningStats<std::int32_t, 16> random;
+	random.add(samples.data(), samples.size());
+
+	long double sum = 0.0L;
+	long double squares = 0.0L;
+	for (const S32F16& sample : samples)
+	{
+		sum += sample.raw();
+		squares += static_cast<long double>(sample.raw()) * sample.raw();
+	}
+
+	long double mean = sum / samples.size();
+	long double variance = squares / samples.size() - mean * mean;
+	EXPECT_NEAR(static_cast<double>(mean), random.mean().raw(), 0.5);
+	EXPECT_NEAR(static_cast<double>(variance / 65536), random.variance().raw(), 1.0);
+	EXPECT_NEAR(static_cast<double>(std::sqrt(variance)), random.standardDeviation().raw(), 1.0);
+	EXPECT_NEAR(static_cast<double>(std::sqrt(squares / samples.size())), random.rms().raw(), 1.0);
+
+	/*
+	 * Empty sets are zero and results saturate to the format
+	 */
+	RunningStats<std::int32_t, 16> empty;
+	EXPECT_EQ(0.0, empty.mean().toDouble());
+	EXPECT_EQ(0.0, empty.variance().toDouble());
+	EXPECT_EQ(0.0, empty.min().toDouble());
+
+	RunningStats<std::int16_t, 8> wide;
+	wide.add(FixedPoint<std::int16_t, 8>(-100.0));
+	wide.add(FixedPoint<std::int16_t, 8>(100.0));
+	EXPECT_EQ(std::numeric_limits<std::int16_t>::max(), wide.variance().raw());
+	EXPECT_EQ(100.0, wide.standardDeviation().toDouble());
+
+	wide.reset();
+	EXPECT_EQ(0u, wide.count());
+}
+
+TEST(RunningStats, Sliding)
+{
+	typedef FixedPoint<std::int16_t, 8> S16F8;
+
+	std::vector<S16F8> samples = randomSamples<std::int16_t, 8>(2000, 3);
+
+	for (std::size_t window : { 1u, 7u, 64u })
+	{
+		SlidingStats<std::int16_t, 8> sliding(window);
+		EXPECT_EQ(window, sliding.window());
+
+		for (std::size_t i = 0; i < samples.size(); ++i)
+		{
+			sliding.add(samples[i]);
+
+			std::size_t first = i + 1 > window ? i + 1 - window : 0;
+			RunningStats<std::int16_t, 8> expected;
+			expected.add(samples.data() + first, i + 1 - first);
+
+			RunningStats<std::int16_t, 8> actual = sliding.stats();
+			ASSERT_EQ(expected.count(), actual.count());
+			ASSERT_TRUE(expected.sum() == actual.sum()) << window << ", " << i;
+			ASSERT_TRUE(expected.sumSquares() == actual.sumSquares()) << window << ", " << i;
+			ASSERT_EQ(expected.min().raw(), actual.min().raw()) << window << ", " << i;
+			ASSERT_EQ(expected.max().raw(), actual.max().raw()) << window << ", " << i;
+			ASSERT_EQ(expected.variance().raw(), actual.variance().raw()) << window << ", " << i;
+		}
+	}
+
+	/*
+	 * Monotonic runs exercise the queues at their longest
+	 */
+	SlidingStats<std::int16_t, 8> rising(5);
+	for (int i = 0; i < 20; ++i)
+	{
+		rising.add(S16F8(static_cast<double>(i)));
+	}
+
+	EXPECT_EQ(15.0, rising.stats().min().toDouble());
+	EXPECT_EQ(19.0, rising.stats().max().toDouble());
+	EXPECT_EQ(17.0, rising.stats().mean().toDouble());
+
+	rising.reset();
+	EXPECT_EQ(0u, rising.size());
+	EXPECT_EQ(0u, rising.stats().count());
+
+	rising.add(S16F8(-1.5));
+	EXPECT_EQ(-1.5, rising.stats().max().toDouble());
+}